@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Сравнивает результаты Google Benchmark (JSON) с сохранённой базой.
+
+Использование: s21_bench_compare.py BASELINE CURRENT [--threshold 0.10]
+
+Для каждого замера, который есть в обоих файлах, сравнивается real_time
+(при повторах - медиана). Код возврата 1, если хотя бы один замер стал
+медленнее базы больше чем на threshold (доля). Замеры, которых нет в одном
+из файлов, только перечисляются. Если файла базы нет, сравнение
+пропускается: базу сохраняет make bench_baseline.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+def load_times(path):
+    """Возвращает {имя замера: real_time в наносекундах}."""
+    with open(path) as f:
+        data = json.load(f)
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    times = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+            name = bench["run_name"]
+        elif "repetitions" in bench and bench.get("repetitions", 1) > 1:
+            continue  # Отдельные повторы: берётся их медиана
+        else:
+            name = bench["name"]
+        times[name] = bench["real_time"] * scale[bench.get("time_unit", "ns")]
+    return times
+
+
+def format_time(ns):
+    for unit, size in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= size:
+            return "%.3g %s" % (ns / size, unit)
+    return "%.3g ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="допустимое замедление (доля), по умолчанию 0.10")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print("No baseline '%s', comparison skipped (run make bench_baseline)"
+              % args.baseline)
+        return 0
+
+    baseline = load_times(args.baseline)
+    current = load_times(args.current)
+
+    regressions = []
+    width = max([len(name) for name in current] + [9])
+    print("%-*s %12s %12s %8s" % (width, "Benchmark", "Baseline", "Current",
+                                  "Change"))
+    for name in sorted(set(baseline) & set(current)):
+        old, new = baseline[name], current[name]
+        change = new / old - 1 if old > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            regressions.append(name)
+            mark = "  REGRESSION"
+        print("%-*s %12s %12s %+7.1f%%%s" % (width, name, format_time(old),
+                                             format_time(new), change * 100,
+                                             mark))
+
+    for name in sorted(set(current) - set(baseline)):
+        print("%-*s (new)" % (width, name))
+    for name in sorted(set(baseline) - set(current)):
+        print("%-*s (missing)" % (width, name))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than baseline by more than %.0f%%:"
+              % (len(regressions), args.threshold * 100))
+        for name in regressions:
+            print("  " + name)
+        return 1
+    print("\nNo regressions above %.0f%%" % (args.threshold * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
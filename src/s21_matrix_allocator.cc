@@ -0,0 +1,209 @@
+#include "s21_matrix_allocator.h"
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+// Классы размеров пула: 256 байт, затем по четыре класса на каждый
+// промежуток (2^k, 2^(k+1)] вплоть до S21PoolAllocator::kMaxPooled
+constexpr int kMinShift = 8;
+constexpr int kMaxShift = 28;
+constexpr int kClassesPerPow2 = 4;
+constexpr int kClassCount = (kMaxShift - kMinShift) * kClassesPerPow2 + 1;
+
+// Возвращает номер класса для bytes и записывает размер класса в class_bytes
+int SizeClass(std::size_t bytes, std::size_t *class_bytes) {
+  int result = 0;
+  if (bytes <= (std::size_t(1) << kMinShift)) {
+    *class_bytes = std::size_t(1) << kMinShift;
+  } else {
+    int k = 63 - __builtin_clzll((unsigned long long)(bytes - 1));
+    std::size_t base = std::size_t(1) << k, step = base / kClassesPerPow2;
+    std::size_t quarter = (bytes - base + step - 1) / step;  // 1..4
+    *class_bytes = base + quarter * step;
+    result = 1 + (k - kMinShift) * kClassesPerPow2 + (int)(quarter - 1);
+  }
+  return result;
+}
+
+// Кэш свободных буферов одного потока
+struct ThreadCache {
+  std::vector<void *> free_lists[kClassCount];
+  std::size_t cached_bytes = 0;
+
+  ~ThreadCache();
+
+  void Clear() {
+    for (int i = 0; i < kClassCount; i++) {
+      for (void *ptr : free_lists[i])
+        S21HeapAllocator::Instance().Deallocate(ptr, 0);
+      free_lists[i].clear();
+    }
+    cached_bytes = 0;
+  }
+};
+
+thread_local ThreadCache thread_cache;
+// Истина после разрушения thread_cache при завершении потока: буферы
+// статических матриц, разрушаемых позже, уходят сразу в кучу
+thread_local bool thread_cache_destroyed = false;
+
+thread_local S21MatrixAllocator *scope_allocator = nullptr;
+std::atomic<S21MatrixAllocator *> default_allocator{nullptr};
+
+ThreadCache::~ThreadCache() {
+  Clear();
+  thread_cache_destroyed = true;
+}
+
+std::size_t AlignUp(std::size_t bytes) {
+  const std::size_t mask = S21MatrixAllocator::kAlignment - 1;
+  return (bytes + mask) & ~mask;
+}
+
+}  // namespace
+
+// КУЧА
+
+S21HeapAllocator &S21HeapAllocator::Instance() {
+  static S21HeapAllocator allocator;
+  return allocator;
+}
+
+void *S21HeapAllocator::Allocate(std::size_t bytes) {
+  return ::operator new(bytes, std::align_val_t(kAlignment));
+}
+
+void S21HeapAllocator::Deallocate(void *ptr, std::size_t) {
+  ::operator delete(ptr, std::align_val_t(kAlignment));
+}
+
+// ПУЛ
+
+S21PoolAllocator &S21PoolAllocator::Instance() {
+  static S21PoolAllocator allocator;
+  return allocator;
+}
+
+void *S21PoolAllocator::Allocate(std::size_t bytes) {
+  if (bytes > kMaxPooled || thread_cache_destroyed)
+    return S21HeapAllocator::Instance().Allocate(bytes);
+
+  std::size_t class_bytes = 0;
+  std::vector<void *> &list = thread_cache.free_lists[SizeClass(bytes,
+                                                                &class_bytes)];
+  void *result = nullptr;
+  if (!list.empty()) {
+    result = list.back();
+    list.pop_back();
+    thread_cache.cached_bytes -= class_bytes;
+  } else {
+    result = S21HeapAllocator::Instance().Allocate(class_bytes);
+  }
+  return result;
+}
+
+// Буфер, освобождённый в другом потоке, попадает в кэш этого потока: все
+// буферы класса одинакового размера, поэтому это безопасно
+void S21PoolAllocator::Deallocate(void *ptr, std::size_t bytes) {
+  if (bytes > kMaxPooled || thread_cache_destroyed) {
+    S21HeapAllocator::Instance().Deallocate(ptr, bytes);
+    return;
+  }
+
+  std::size_t class_bytes = 0;
+  std::vector<void *> &list = thread_cache.free_lists[SizeClass(bytes,
+                                                                &class_bytes)];
+  if ((int)list.size() < kMaxCachedPerClass &&
+      thread_cache.cached_bytes + class_bytes <= kMaxCachedBytes) {
+    list.push_back(ptr);
+    thread_cache.cached_bytes += class_bytes;
+  } else {
+    S21HeapAllocator::Instance().Deallocate(ptr, class_bytes);
+  }
+}
+
+void S21PoolAllocator::Trim() {
+  if (!thread_cache_destroyed) thread_cache.Clear();
+}
+
+std::size_t S21PoolAllocator::CachedBytes() const {
+  return thread_cache_destroyed ? 0 : thread_cache.cached_bytes;
+}
+
+// АРЕНА
+
+S21MatrixArena::S21MatrixArena(std::size_t block_bytes)
+    : current_(0), block_bytes_(AlignUp(block_bytes ? block_bytes : 1)) {}
+
+S21MatrixArena::~S21MatrixArena() {
+  for (Block &block : blocks_)
+    S21HeapAllocator::Instance().Deallocate(block.data, block.size);
+}
+
+void *S21MatrixArena::Allocate(std::size_t bytes) {
+  bytes = AlignUp(bytes ? bytes : 1);
+
+  while (current_ < blocks_.size() &&
+         blocks_[current_].size - blocks_[current_].used < bytes)
+    current_++;
+
+  if (current_ == blocks_.size()) {
+    std::size_t size = (bytes > block_bytes_) ? bytes : block_bytes_;
+    char *data =
+        static_cast<char *>(S21HeapAllocator::Instance().Allocate(size));
+    blocks_.push_back(Block{data, size, 0});
+  }
+
+  Block &block = blocks_[current_];
+  void *result = block.data + block.used;
+  block.used += bytes;
+  return result;
+}
+
+void S21MatrixArena::Deallocate(void *ptr, std::size_t bytes) {
+  bytes = AlignUp(bytes ? bytes : 1);
+  if (current_ < blocks_.size()) {
+    Block &block = blocks_[current_];
+    if (block.used >= bytes && block.data + block.used - bytes == ptr)
+      block.used -= bytes;
+  }
+}
+
+void S21MatrixArena::Reset() {
+  for (Block &block : blocks_) block.used = 0;
+  current_ = 0;
+}
+
+std::size_t S21MatrixArena::BytesUsed() const {
+  std::size_t result = 0;
+  for (const Block &block : blocks_) result += block.used;
+  return result;
+}
+
+std::size_t S21MatrixArena::BytesReserved() const {
+  std::size_t result = 0;
+  for (const Block &block : blocks_) result += block.size;
+  return result;
+}
+
+// ТЕКУЩИЙ РАСПРЕДЕЛИТЕЛЬ
+
+S21AllocatorScope::S21AllocatorScope(S21MatrixAllocator &allocator)
+    : previous_(scope_allocator) {
+  scope_allocator = &allocator;
+}
+
+S21AllocatorScope::~S21AllocatorScope() { scope_allocator = previous_; }
+
+S21MatrixAllocator &S21CurrentAllocator() {
+  S21MatrixAllocator *result = scope_allocator;
+  if (!result) result = default_allocator.load(std::memory_order_acquire);
+  if (!result) result = &S21HeapAllocator::Instance();
+  return *result;
+}
+
+void S21SetDefaultAllocator(S21MatrixAllocator *allocator) {
+  default_allocator.store(allocator, std::memory_order_release);
+}
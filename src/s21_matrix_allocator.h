@@ -0,0 +1,110 @@
+#ifndef __S21MATRIX_ALLOCATOR_H__
+#define __S21MATRIX_ALLOCATOR_H__
+
+#include <cstddef>
+#include <vector>
+
+// Распределители памяти для буферов S21Matrix.
+//
+// Каждая матрица запоминает распределитель, из которого получен её буфер, и
+// возвращает буфер именно ему. Новые буферы берутся из текущего
+// распределителя потока: его задаёт S21AllocatorScope, а вне областей
+// используется распределитель по умолчанию (S21SetDefaultAllocator, изначально
+// обычная куча).
+
+// Интерфейс распределителя. Все буферы выровнены по kAlignment байт.
+class S21MatrixAllocator {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  virtual ~S21MatrixAllocator() = default;
+
+  virtual void *Allocate(std::size_t bytes) = 0;
+  // bytes - тот же размер, что был передан в Allocate
+  virtual void Deallocate(void *ptr, std::size_t bytes) = 0;
+  // Можно ли писать в буферы этого распределителя. Матрица с буфером только
+  // для чтения перед первой записью копирует его в текущий распределитель.
+  virtual bool Writable() const { return true; }
+};
+
+// Выровненный operator new / delete
+class S21HeapAllocator : public S21MatrixAllocator {
+ public:
+  static S21HeapAllocator &Instance();
+
+  void *Allocate(std::size_t bytes) override;
+  void Deallocate(void *ptr, std::size_t bytes) override;
+};
+
+// Пул по классам размеров со своими списками свободных буферов в каждом
+// потоке: освобождённый буфер остаётся в кэше потока и отдаётся следующему
+// запросу того же класса без обращения к глобальной куче. Классы идут по
+// четыре на каждую степень двойки, поэтому запас не превышает 25%.
+class S21PoolAllocator : public S21MatrixAllocator {
+ public:
+  // Буферы больше kMaxPooled байт всегда идут в кучу
+  static constexpr std::size_t kMaxPooled = std::size_t(1) << 28;
+  // Предел кэша одного потока
+  static constexpr std::size_t kMaxCachedBytes = std::size_t(1) << 28;
+  static constexpr int kMaxCachedPerClass = 16;
+
+  static S21PoolAllocator &Instance();
+
+  void *Allocate(std::size_t bytes) override;
+  void Deallocate(void *ptr, std::size_t bytes) override;
+
+  // Возвращает в кучу все буферы из кэша текущего потока
+  void Trim();
+  // Сколько байт сейчас лежит в кэше текущего потока
+  std::size_t CachedBytes() const;
+};
+
+// Арена для пачки временных матриц: память выделяется сдвигом указателя
+// внутри больших блоков и освобождается вся сразу (Reset или деструктор).
+// Deallocate возвращает память, только если буфер был выделен последним.
+//
+// Арена не потокобезопасна, а матрицы из неё не должны её пережить.
+class S21MatrixArena : public S21MatrixAllocator {
+ public:
+  explicit S21MatrixArena(std::size_t block_bytes = std::size_t(1) << 20);
+  S21MatrixArena(const S21MatrixArena &) = delete;
+  S21MatrixArena &operator=(const S21MatrixArena &) = delete;
+  ~S21MatrixArena() override;
+
+  void *Allocate(std::size_t bytes) override;
+  void Deallocate(void *ptr, std::size_t bytes) override;
+
+  void Reset();  // Делает всю память арены снова свободной
+  std::size_t BytesUsed() const;
+  std::size_t BytesReserved() const;
+
+ private:
+  struct Block {
+    char *data;
+    std::size_t size;
+    std::size_t used;
+  };
+
+  std::vector<Block> blocks_;
+  std::size_t current_;  // Блок, из которого идёт выделение
+  std::size_t block_bytes_;
+};
+
+// Делает allocator текущим для потока до конца области видимости
+class S21AllocatorScope {
+ public:
+  explicit S21AllocatorScope(S21MatrixAllocator &allocator);
+  S21AllocatorScope(const S21AllocatorScope &) = delete;
+  S21AllocatorScope &operator=(const S21AllocatorScope &) = delete;
+  ~S21AllocatorScope();
+
+ private:
+  S21MatrixAllocator *previous_;
+};
+
+// Текущий распределитель потока
+S21MatrixAllocator &S21CurrentAllocator();
+// Распределитель по умолчанию для всех потоков (nullptr - обычная куча)
+void S21SetDefaultAllocator(S21MatrixAllocator *allocator);
+
+#endif
@@ -0,0 +1,477 @@
+#include "s21_matrix_batch.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_thread_pool.h"
+
+namespace {
+
+constexpr int kLanes = S21MatrixBatch::kLanes;
+
+// Пакеты с объёмом работы (умножений на все матрицы) меньше этого порога не
+// делятся между потоками
+constexpr double kParallelWork = 1 << 16;
+constexpr double kParallelGrain = 1 << 14;
+
+// Аргументы ядер. Все массивы - группы по kLanes матриц; элемент (i, j)
+// группы - kLanes подряд идущих чисел, по одному на матрицу.
+struct BatchArgs {
+  const double *a;  // Операнд, группы m x k (для умножения) или m x n
+  const double *b;  // Второй множитель, группы k x n
+  double *c;        // Результат
+  double *det;      // Определители, kLanes на группу
+  int m, k, n;
+};
+
+// Ядро для одной группы; work - рабочий буфер потока
+using GroupKernel = void (*)(const BatchArgs &args, int group, double *work);
+
+// Ядра групп встраиваются в варианты RunDefault / RunAvx2 / RunAvx512 ниже
+// и векторизуются компилятором под набор инструкций варианта: каждый цикл
+// по l - одна векторная операция над kLanes матрицами.
+#define S21_BATCH_INLINE inline __attribute__((always_inline))
+
+S21_BATCH_INLINE double *Lanes(double *group, int cols, int i, int j) {
+  return group + ((std::size_t)i * cols + j) * kLanes;
+}
+
+S21_BATCH_INLINE const double *Lanes(const double *group, int cols, int i,
+                                     int j) {
+  return group + ((std::size_t)i * cols + j) * kLanes;
+}
+
+S21_BATCH_INLINE void MulGroup(const BatchArgs &args, int g, double *) {
+  const int m = args.m, k = args.k, n = args.n;
+  const double *a = args.a + (std::size_t)g * m * k * kLanes;
+  const double *b = args.b + (std::size_t)g * k * n * kLanes;
+  double *c = args.c + (std::size_t)g * m * n * kLanes;
+
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < n; j++) {
+      double sum[kLanes] = {};
+      for (int p = 0; p < k; p++) {
+        const double *x = Lanes(a, k, i, p), *y = Lanes(b, n, p, j);
+        for (int l = 0; l < kLanes; l++) sum[l] += x[l] * y[l];
+      }
+      double *z = Lanes(c, n, i, j);
+      for (int l = 0; l < kLanes; l++) z[l] = sum[l];
+    }
+}
+
+S21_BATCH_INLINE void TransposeGroup(const BatchArgs &args, int g, double *) {
+  const int m = args.m, n = args.n;
+  const double *a = args.a + (std::size_t)g * m * n * kLanes;
+  double *c = args.c + (std::size_t)g * m * n * kLanes;
+
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < n; j++) {
+      const double *x = Lanes(a, n, i, j);
+      double *z = Lanes(c, m, j, i);
+      for (int l = 0; l < kLanes; l++) z[l] = x[l];
+    }
+}
+
+// Частичный выбор ведущего элемента в столбце k (строки k..n-1 буфера w
+// шириной cols) - у каждой матрицы свой. Строки меняются выбором по маске,
+// без ветвлений по матрицам; столбцы левее first уже нулевые и не трогаются.
+// det умножается на ведущий элемент (со сменой знака при перестановке), в
+// inv - обратный к нему или 0 для вырожденного столбца.
+S21_BATCH_INLINE void Pivot(double *w, int n, int cols, int k, int first,
+                            double *det, double *inv) {
+  double row[kLanes], best[kLanes];
+  const double *wk = Lanes(w, cols, k, k);
+  for (int l = 0; l < kLanes; l++) {
+    row[l] = k;
+    best[l] = std::fabs(wk[l]);
+  }
+  for (int i = k + 1; i < n; i++) {
+    const double *wi = Lanes(w, cols, i, k);
+    for (int l = 0; l < kLanes; l++) {
+      double v = std::fabs(wi[l]);
+      bool better = v > best[l];
+      best[l] = better ? v : best[l];
+      row[l] = better ? i : row[l];
+    }
+  }
+
+  for (int i = k + 1; i < n; i++) {
+    bool any = false;
+    for (int l = 0; l < kLanes; l++) any |= row[l] == i;
+    if (!any) continue;
+    for (int j = first; j < cols; j++) {
+      double *x = Lanes(w, cols, k, j), *y = Lanes(w, cols, i, j);
+      for (int l = 0; l < kLanes; l++) {
+        bool swap = row[l] == i;
+        double t = x[l];
+        x[l] = swap ? y[l] : t;
+        y[l] = swap ? t : y[l];
+      }
+    }
+  }
+
+  for (int l = 0; l < kLanes; l++) {
+    double pivot = wk[l];
+    det[l] *= row[l] != k ? -pivot : pivot;
+    inv[l] = pivot != 0 ? 1.0 / pivot : 0.0;
+  }
+}
+
+// Миноры 2x2 матрицы 3x3 - алгебраические дополнения без знака (знак
+// учтён циклическим порядком строк и столбцов)
+S21_BATCH_INLINE void Cofactors3(const double *a, double (*c)[3][kLanes]) {
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+      int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      const double *p = Lanes(a, 3, i1, j1), *q = Lanes(a, 3, i2, j2);
+      const double *r = Lanes(a, 3, i1, j2), *s = Lanes(a, 3, i2, j1);
+      for (int l = 0; l < kLanes; l++) c[i][j][l] = p[l] * q[l] - r[l] * s[l];
+    }
+}
+
+// Матрицы до 3x3 - по явным формулам, больше - исключением Гаусса
+S21_BATCH_INLINE void DetGroup(const BatchArgs &args, int g, double *w) {
+  const int n = args.n;
+  const double *a = args.a + (std::size_t)g * n * n * kLanes;
+  double *det = args.det + (std::size_t)g * kLanes;
+
+  if (n == 1) {
+    for (int l = 0; l < kLanes; l++) det[l] = a[l];
+  } else if (n == 2) {
+    const double *a00 = Lanes(a, 2, 0, 0), *a01 = Lanes(a, 2, 0, 1);
+    const double *a10 = Lanes(a, 2, 1, 0), *a11 = Lanes(a, 2, 1, 1);
+    for (int l = 0; l < kLanes; l++)
+      det[l] = a00[l] * a11[l] - a01[l] * a10[l];
+  } else if (n == 3) {
+    double c[3][3][kLanes];
+    Cofactors3(a, c);
+    for (int l = 0; l < kLanes; l++) det[l] = 0;
+    for (int j = 0; j < 3; j++) {
+      const double *x = Lanes(a, 3, 0, j);
+      for (int l = 0; l < kLanes; l++) det[l] += x[l] * c[0][j][l];
+    }
+  } else {
+    for (std::size_t e = 0; e < (std::size_t)n * n * kLanes; e++) w[e] = a[e];
+    double result[kLanes], inv[kLanes];
+    for (int l = 0; l < kLanes; l++) result[l] = 1;
+    for (int k = 0; k < n; k++) {
+      Pivot(w, n, n, k, k, result, inv);
+      for (int i = k + 1; i < n; i++) {
+        double f[kLanes];
+        const double *wik = Lanes(w, n, i, k);
+        for (int l = 0; l < kLanes; l++) f[l] = wik[l] * inv[l];
+        for (int j = k + 1; j < n; j++) {
+          double *x = Lanes(w, n, i, j);
+          const double *y = Lanes(w, n, k, j);
+          for (int l = 0; l < kLanes; l++) x[l] -= f[l] * y[l];
+        }
+      }
+    }
+    for (int l = 0; l < kLanes; l++) det[l] = result[l];
+  }
+}
+
+// Матрицы до 3x3 - через присоединённую матрицу, больше - методом
+// Гаусса-Жордана над [A | E] в рабочем буфере n x 2n. Определители
+// сохраняются для проверки вырожденности; у вырожденных матриц результат
+// не определён.
+S21_BATCH_INLINE void InverseGroup(const BatchArgs &args, int g, double *w) {
+  const int n = args.n;
+  const double *a = args.a + (std::size_t)g * n * n * kLanes;
+  double *c = args.c + (std::size_t)g * n * n * kLanes;
+  double *det = args.det + (std::size_t)g * kLanes;
+  double inv[kLanes];
+
+  if (n == 1) {
+    for (int l = 0; l < kLanes; l++) {
+      det[l] = a[l];
+      c[l] = a[l] != 0 ? 1.0 / a[l] : 0.0;
+    }
+  } else if (n == 2) {
+    const double *a00 = Lanes(a, 2, 0, 0), *a01 = Lanes(a, 2, 0, 1);
+    const double *a10 = Lanes(a, 2, 1, 0), *a11 = Lanes(a, 2, 1, 1);
+    double *c00 = Lanes(c, 2, 0, 0), *c01 = Lanes(c, 2, 0, 1);
+    double *c10 = Lanes(c, 2, 1, 0), *c11 = Lanes(c, 2, 1, 1);
+    for (int l = 0; l < kLanes; l++) {
+      det[l] = a00[l] * a11[l] - a01[l] * a10[l];
+      inv[l] = det[l] != 0 ? 1.0 / det[l] : 0.0;
+      double x00 = a00[l], x01 = a01[l], x10 = a10[l], x11 = a11[l];
+      c00[l] = x11 * inv[l];
+      c01[l] = -x01 * inv[l];
+      c10[l] = -x10 * inv[l];
+      c11[l] = x00 * inv[l];
+    }
+  } else if (n == 3) {
+    double cof[3][3][kLanes];
+    Cofactors3(a, cof);
+    for (int l = 0; l < kLanes; l++) det[l] = 0;
+    for (int j = 0; j < 3; j++) {
+      const double *x = Lanes(a, 3, 0, j);
+      for (int l = 0; l < kLanes; l++) det[l] += x[l] * cof[0][j][l];
+    }
+    for (int l = 0; l < kLanes; l++) inv[l] = det[l] != 0 ? 1.0 / det[l] : 0.0;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        double *z = Lanes(c, 3, j, i);
+        for (int l = 0; l < kLanes; l++) z[l] = cof[i][j][l] * inv[l];
+      }
+  } else {
+    const int cols = 2 * n;
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++) {
+        const double *x = Lanes(a, n, i, j);
+        double *y = Lanes(w, cols, i, j), *e = Lanes(w, cols, i, n + j);
+        for (int l = 0; l < kLanes; l++) {
+          y[l] = x[l];
+          e[l] = i == j ? 1.0 : 0.0;
+        }
+      }
+
+    double result[kLanes];
+    for (int l = 0; l < kLanes; l++) result[l] = 1;
+    for (int k = 0; k < n; k++) {
+      Pivot(w, n, cols, k, k, result, inv);
+      for (int j = k; j < cols; j++) {
+        double *x = Lanes(w, cols, k, j);
+        for (int l = 0; l < kLanes; l++) x[l] *= inv[l];
+      }
+      for (int i = 0; i < n; i++) {
+        if (i == k) continue;
+        double f[kLanes];
+        const double *wik = Lanes(w, cols, i, k);
+        for (int l = 0; l < kLanes; l++) f[l] = wik[l];
+        for (int j = k; j < cols; j++) {
+          double *x = Lanes(w, cols, i, j);
+          const double *y = Lanes(w, cols, k, j);
+          for (int l = 0; l < kLanes; l++) x[l] -= f[l] * y[l];
+        }
+      }
+    }
+
+    for (int l = 0; l < kLanes; l++) det[l] = result[l];
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++) {
+        const double *x = Lanes(w, cols, i, n + j);
+        double *z = Lanes(c, n, i, j);
+        for (int l = 0; l < kLanes; l++) z[l] = x[l];
+      }
+  }
+}
+
+#undef S21_BATCH_INLINE
+
+// Обход групп [lo, hi) с рабочим буфером из work_size чисел
+using GroupRange = void (*)(const BatchArgs &args, int lo, int hi,
+                            std::size_t work_size);
+
+template <GroupKernel kernel>
+void RunDefault(const BatchArgs &args, int lo, int hi, std::size_t work_size) {
+  std::vector<double> work(work_size);
+  for (int g = lo; g < hi; g++) kernel(args, g, work.data());
+}
+
+template <GroupKernel kernel>
+__attribute__((target("avx2,fma"))) void RunAvx2(const BatchArgs &args,
+                                                 int lo, int hi,
+                                                 std::size_t work_size) {
+  std::vector<double> work(work_size);
+  for (int g = lo; g < hi; g++) kernel(args, g, work.data());
+}
+
+template <GroupKernel kernel>
+__attribute__((target("avx512f"))) void RunAvx512(const BatchArgs &args,
+                                                  int lo, int hi,
+                                                  std::size_t work_size) {
+  std::vector<double> work(work_size);
+  for (int g = lo; g < hi; g++) kernel(args, g, work.data());
+}
+
+// Вариант под набор инструкций, выбранный для остальных ядер библиотеки
+template <GroupKernel kernel>
+GroupRange SelectRange() {
+  switch (S21GetKernels().isa) {
+    case S21Isa::kAvx512:
+      return RunAvx512<kernel>;
+    case S21Isa::kAvx2:
+      return RunAvx2<kernel>;
+    default:
+      return RunDefault<kernel>;
+  }
+}
+
+// Запускает ядро для всех групп; group_work - умножений на группу
+template <GroupKernel kernel>
+void ForEachGroup(int groups, double group_work, bool parallel,
+                  const BatchArgs &args, std::size_t work_size = 0) {
+  GroupRange range = SelectRange<kernel>();
+  double work = groups * group_work;
+  if (!parallel || work < kParallelWork || S21GetNumThreads() == 1) {
+    range(args, 0, groups, work_size);
+  } else {
+    int grain = (int)(kParallelGrain / group_work);
+    S21ThreadPool::Instance().ParallelFor(
+        0, groups, grain < 1 ? 1 : grain,
+        [&](int lo, int hi) { range(args, lo, hi, work_size); });
+  }
+}
+
+}  // namespace
+
+// КОНСТРУКТОРЫ
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols), parallel_(true) {
+  if (count <= 0 || rows <= 0 || cols <= 0) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  data_.assign((std::size_t)Groups() * rows * cols * kLanes, 0.0);
+}
+
+// МЕТОДЫ
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch &other) {
+  *this = *this * other;
+}
+
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  S21MatrixBatch result(count_, cols_, rows_);
+  result.parallel_ = parallel_;
+  BatchArgs args = {data_.data(), nullptr, result.data_.data(), nullptr,
+                    rows_, 0, cols_};
+  ForEachGroup<TransposeGroup>(Groups(), (double)rows_ * cols_ * kLanes,
+                               parallel_, args);
+  return result;
+}
+
+std::vector<double> S21MatrixBatch::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::out_of_range(
+        "Incorrect input: you can't get a determinant for matrix that is not "
+        "square.");
+  }
+
+  std::vector<double> result((std::size_t)Groups() * kLanes);
+  BatchArgs args = {data_.data(), nullptr, nullptr, result.data(),
+                    rows_, 0, rows_};
+  ForEachGroup<DetGroup>(Groups(), (double)rows_ * rows_ * rows_ * kLanes,
+                         parallel_, args,
+                         (std::size_t)rows_ * rows_ * kLanes);
+  result.resize(count_);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::out_of_range(
+        "Incorrect input: you can't inverse matrix that is not square.");
+  }
+
+  S21MatrixBatch result(count_, rows_, cols_);
+  result.parallel_ = parallel_;
+  std::vector<double> det((std::size_t)Groups() * kLanes);
+  BatchArgs args = {data_.data(), nullptr, result.data_.data(), det.data(),
+                    rows_, 0, rows_};
+  ForEachGroup<InverseGroup>(Groups(),
+                             2.0 * rows_ * rows_ * rows_ * kLanes, parallel_,
+                             args, (std::size_t)rows_ * 2 * rows_ * kLanes);
+
+  for (int b = 0; b < count_; b++) {
+    if (det[b] == 0) {
+      throw std::out_of_range(
+          "Incorrect input: you can't inverse matrix if it's determinant is "
+          "equal to zero.");
+    }
+  }
+
+  return result;
+}
+
+// ПЕРЕГРУЗКА ОПЕРАТОРОВ
+
+S21MatrixBatch S21MatrixBatch::operator*(const S21MatrixBatch &other) const {
+  if (count_ != other.count_) {
+    throw std::out_of_range(
+        "Incorrect input: batches should have the same number of matrices.");
+  }
+  if (cols_ != other.rows_) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
+
+  S21MatrixBatch result(count_, rows_, other.cols_);
+  result.parallel_ = parallel_;
+  BatchArgs args = {data_.data(), other.data_.data(), result.data_.data(),
+                    nullptr,      rows_,              cols_,
+                    other.cols_};
+  ForEachGroup<MulGroup>(Groups(),
+                         (double)rows_ * cols_ * other.cols_ * kLanes,
+                         parallel_, args);
+  return result;
+}
+
+S21MatrixBatch &S21MatrixBatch::operator*=(const S21MatrixBatch &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+double &S21MatrixBatch::operator()(int index, int row, int col) {
+  CheckIndex(index, row, col);
+  return data_[Index(index, row, col)];
+}
+
+double S21MatrixBatch::operator()(int index, int row, int col) const {
+  CheckIndex(index, row, col);
+  return data_[Index(index, row, col)];
+}
+
+// ACCESSORS И MUTATORS
+
+int S21MatrixBatch::GetCount() const { return count_; }
+
+int S21MatrixBatch::GetRows() const { return rows_; }
+
+int S21MatrixBatch::GetCols() const { return cols_; }
+
+void S21MatrixBatch::SetMatrix(int index, const S21Matrix &matrix) {
+  CheckIndex(index, 0, 0);
+  S21MatrixLeaf leaf = matrix.Leaf();
+  if (leaf.Rows() != rows_ || leaf.Cols() != cols_) {
+    throw std::out_of_range(
+        "Incorrect input: matriсes should have the same size.");
+  }
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) data_[Index(index, i, j)] = leaf.Eval(i, j);
+}
+
+S21Matrix S21MatrixBatch::GetMatrix(int index) const {
+  CheckIndex(index, 0, 0);
+  S21Matrix result(rows_, cols_);
+  double *dst = result.WritableData();
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++)
+      dst[(std::size_t)i * result.Stride() + j] = data_[Index(index, i, j)];
+  return result;
+}
+
+void S21MatrixBatch::SetParallel(bool parallel) { parallel_ = parallel; }
+
+bool S21MatrixBatch::GetParallel() const { return parallel_; }
+
+// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+
+int S21MatrixBatch::Groups() const { return (count_ + kLanes - 1) / kLanes; }
+
+std::size_t S21MatrixBatch::Index(int index, int row, int col) const {
+  std::size_t group = index / kLanes;
+  return ((group * rows_ + row) * cols_ + col) * kLanes + index % kLanes;
+}
+
+void S21MatrixBatch::CheckIndex(int index, int row, int col) const {
+  if (index < 0 || index >= count_ || row < 0 || row >= rows_ || col < 0 ||
+      col >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef __S21MATRIX_BATCH_H__
+#define __S21MATRIX_BATCH_H__
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Пакет из count матриц одного размера rows x cols для массовых операций над
+// мелкими матрицами (3x3, 4x4, 6x6...) одним вызовом.
+//
+// Матрицы хранятся группами по kLanes с чередованием: сначала элемент (0, 0)
+// всех матриц группы, затем (0, 1) и так далее. Поэтому каждое скалярное
+// действие алгоритма выполняется сразу над kLanes матрицами в одном
+// векторном регистре. Ядра собираются под SSE2, AVX2 и AVX-512 и выбираются
+// по процессору так же, как в s21_matrix_kernels.h. Большие пакеты делятся
+// между потоками пула (SetParallel(false) отключает деление).
+class S21MatrixBatch {
+ public:
+  static constexpr int kLanes = 8;  // Матриц в группе (ширина zmm)
+
+  // Конструкторы
+  S21MatrixBatch(int count, int rows, int cols);  // count нулевых матриц
+
+  // Методы (выполняются для каждой матрицы пакета)
+  void MulMatrix(const S21MatrixBatch &other);  // this[b] = this[b] * other[b]
+  S21MatrixBatch Transpose() const;
+  std::vector<double> Determinant() const;  // Определитель каждой матрицы
+  S21MatrixBatch InverseMatrix() const;
+
+  // Перегрузка операторов
+  S21MatrixBatch operator*(const S21MatrixBatch &other) const;
+  S21MatrixBatch &operator*=(const S21MatrixBatch &other);
+  // Элемент (row, col) матрицы index
+  double &operator()(int index, int row, int col);
+  double operator()(int index, int row, int col) const;
+
+  // Accessors и mutators
+  int GetCount() const;
+  int GetRows() const;
+  int GetCols() const;
+  void SetMatrix(int index, const S21Matrix &matrix);  // Копирует матрицу
+  S21Matrix GetMatrix(int index) const;
+  void SetParallel(bool parallel);  // Делить ли большие пакеты между потоками
+  bool GetParallel() const;
+
+ private:
+  int Groups() const;  // Число групп по kLanes (последняя может быть неполной)
+  std::size_t Index(int index, int row, int col) const;
+  void CheckIndex(int index, int row, int col) const;
+
+  int count_, rows_, cols_;
+  bool parallel_;
+  std::vector<double> data_;  // Groups() * rows_ * cols_ * kLanes элементов
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef __S21MATRIX_EXPR_H__
+#define __S21MATRIX_EXPR_H__
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// Шаблоны выражений для поэлементной арифметики S21Matrix.
+//
+// Операторы +, - и * (на число) не считают результат сразу, а возвращают
+// лёгкий объект-выражение. Выражение вычисляется одним проходом по памяти
+// при присваивании в S21Matrix (конструктор, =, += и -=), поэтому
+// A + B - C * 2.0 не создаёт промежуточных матриц.
+//
+// Выражение хранит указатели на данные матриц-операндов: его нельзя
+// сохранять (например, через auto) дольше, чем живут эти матрицы.
+
+// Базовый класс выражения (CRTP). Узлы задают тип элементов value_type и
+// реализуют Rows(), Cols() и Eval(i, j) - значение элемента без проверки
+// индексов.
+template <class E>
+class S21MatrixExpr {
+ public:
+  const E &Self() const { return static_cast<const E &>(*this); }
+
+  int GetRows() const { return Self().Rows(); }
+  int GetCols() const { return Self().Cols(); }
+
+  // Индексация по элементам выражения (строка, колонка)
+  auto operator()(int i, int j) const {
+    if (i >= GetRows() || j >= GetCols() || i < 0 || j < 0) {
+      throw std::out_of_range("Incorrect input, index is out of range.");
+    }
+    return Self().Eval(i, j);
+  }
+};
+
+// Лист выражения - данные существующей матрицы с элементами типа T
+template <class T>
+class S21MatrixLeafT : public S21MatrixExpr<S21MatrixLeafT<T>> {
+ public:
+  using value_type = T;
+
+  S21MatrixLeafT(const T *data, int stride, int rows, int cols)
+      : data_(data), stride_(stride), rows_(rows), cols_(cols) {}
+
+  int Rows() const { return rows_; }
+  int Cols() const { return cols_; }
+  T Eval(int i, int j) const { return data_[(std::ptrdiff_t)i * stride_ + j]; }
+
+ private:
+  const T *data_;
+  int stride_, rows_, cols_;
+};
+
+using S21MatrixLeaf = S21MatrixLeafT<double>;
+
+struct S21ExprAssign {
+  template <class T>
+  static T Apply(T, T b) {
+    return b;
+  }
+};
+
+struct S21ExprPlus {
+  template <class T>
+  static T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct S21ExprMinus {
+  template <class T>
+  static T Apply(T a, T b) {
+    return a - b;
+  }
+};
+
+// Поэлементная операция над двумя выражениями одного размера и типа
+// элементов. Размеры проверяются при построении выражения.
+template <class L, class R, class Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExpr<S21MatrixBinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<typename L::value_type,
+                             typename R::value_type>::value,
+                "Operands should have the same element type");
+
+ public:
+  using value_type = typename L::value_type;
+
+  S21MatrixBinaryExpr(const L &left, const R &right)
+      : left_(left), right_(right) {
+    if (left_.Rows() != right_.Rows() || left_.Cols() != right_.Cols()) {
+      throw std::out_of_range(
+          "Incorrect input: matriсes should have the same "
+          "size if you want to sum them.");
+    }
+  }
+
+  int Rows() const { return left_.Rows(); }
+  int Cols() const { return left_.Cols(); }
+  value_type Eval(int i, int j) const {
+    return Op::Apply(left_.Eval(i, j), right_.Eval(i, j));
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+// Умножение выражения на число
+template <class E>
+class S21MatrixScaleExpr : public S21MatrixExpr<S21MatrixScaleExpr<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+  S21MatrixScaleExpr(const E &expr, value_type num) : expr_(expr), num_(num) {}
+
+  int Rows() const { return expr_.Rows(); }
+  int Cols() const { return expr_.Cols(); }
+  value_type Eval(int i, int j) const { return expr_.Eval(i, j) * num_; }
+
+ private:
+  E expr_;
+  value_type num_;
+};
+
+template <class L, class R>
+using S21MatrixSumExpr = S21MatrixBinaryExpr<L, R, S21ExprPlus>;
+
+template <class L, class R>
+using S21MatrixSubExpr = S21MatrixBinaryExpr<L, R, S21ExprMinus>;
+
+#endif
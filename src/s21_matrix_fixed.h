@@ -0,0 +1,355 @@
+#ifndef __S21MATRIX_FIXED_H__
+#define __S21MATRIX_FIXED_H__
+
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Матрица с размерами, известными при компиляции, для мелких преобразований
+// (2x2, 3x3, 4x4). Элементы лежат прямо в объекте (на стеке), циклы имеют
+// постоянные границы и разворачиваются компилятором, а все операции кроме
+// преобразований в S21Matrix и обратно - constexpr.
+//
+// Набор методов и операторов тот же, что у S21Matrix. Несовпадение размеров
+// операндов - ошибка компиляции, а не исключение; Determinant,
+// CalcComplements и InverseMatrix доступны только для квадратных матриц.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "S21FixedMatrix: size should be positive");
+
+ public:
+  // Конструкторы
+  constexpr S21FixedMatrix() : matrix_{} {}  // Нулевая матрица
+  // Построчное заполнение; недостающие элементы равны нулю
+  constexpr S21FixedMatrix(std::initializer_list<double> values) : matrix_{} {
+    if ((int)values.size() > R * C) {
+      throw std::out_of_range("Incorrect input, index is out of range.");
+    }
+    int k = 0;
+    for (double value : values) {
+      matrix_[k / C][k % C] = value;
+      k++;
+    }
+  }
+  explicit S21FixedMatrix(const S21Matrix &other);  // Копия S21Matrix R x C
+
+  // Методы
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    bool result = true;
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++)
+        result = result && matrix_[i][j] == other.matrix_[i][j];
+    return result;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) matrix_[i][j] += other.matrix_[i][j];
+  }
+  constexpr void SubMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) matrix_[i][j] -= other.matrix_[i][j];
+  }
+  constexpr void MulNumber(const double num) {
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) matrix_[i][j] *= num;
+  }
+  constexpr void MulMatrix(const S21FixedMatrix<C, C> &other) {
+    *this = *this * other;
+  }
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) result(j, i) = matrix_[i][j];
+    return result;
+  }
+  constexpr S21FixedMatrix CalcComplements() const;
+  constexpr double Determinant() const;
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  // Перегрузка операторов
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K> &other) const {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i < R; i++)
+      for (int k = 0; k < C; k++)
+        for (int j = 0; j < K; j++)
+          result(i, j) += matrix_[i][k] * other(k, j);
+    return result;
+  }
+  constexpr S21FixedMatrix operator*(const double num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix<C, C> &other) {
+    MulMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(const double num) {
+    MulNumber(num);
+    return *this;
+  }
+  // Индексация по элементам матрицы (строка, колонка)
+  constexpr double &operator()(int i, int j) {
+    if (i >= R || j >= C || i < 0 || j < 0) {
+      throw std::out_of_range("Incorrect input, index is out of range.");
+    }
+    return matrix_[i][j];
+  }
+  constexpr double operator()(int i, int j) const {
+    if (i >= R || j >= C || i < 0 || j < 0) {
+      throw std::out_of_range("Incorrect input, index is out of range.");
+    }
+    return matrix_[i][j];
+  }
+  explicit operator S21Matrix() const { return ToMatrix(); }
+
+  // Accessors
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+  constexpr double *Data() { return &matrix_[0][0]; }  // Строки подряд
+  constexpr const double *Data() const { return &matrix_[0][0]; }
+  S21Matrix ToMatrix() const;  // Копия в S21Matrix R x C
+
+ private:
+  // Минор без строки oy и столбца ox
+  constexpr S21FixedMatrix<R - 1, C - 1> GetMinor(int oy, int ox) const {
+    S21FixedMatrix<R - 1, C - 1> result;
+    for (int i = 0, y = 0; i < R; i++) {
+      if (i == oy) continue;
+      for (int j = 0, x = 0; j < C; j++)
+        if (j != ox) result(y, x++) = matrix_[i][j];
+      y++;
+    }
+    return result;
+  }
+  // Определитель 4x4 через шесть пар миноров 2x2 из верхних и нижних строк
+  constexpr double Determinant4() const;
+  // Определитель LU-разложением с выбором главного элемента по столбцу
+  constexpr double LuDeterminant() const;
+  // Метод Гаусса-Жордана с выбором главного элемента; возвращает
+  // определитель и, если inverse не nullptr, записывает обратную матрицу
+  constexpr double GaussJordan(S21FixedMatrix *inverse) const;
+
+  double matrix_[R][C];
+};
+
+// Определитель: до 4x4 - явные формулы, для больших - LU-разложение
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::Determinant() const {
+  static_assert(R == C, "S21FixedMatrix: determinant needs a square matrix");
+  const auto &m = matrix_;
+  double result = 0;
+  if constexpr (R == 1) {
+    result = m[0][0];
+  } else if constexpr (R == 2) {
+    result = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+  } else if constexpr (R == 3) {
+    result = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+             m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+             m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  } else if constexpr (R == 4) {
+    result = Determinant4();
+  } else {
+    result = LuDeterminant();
+  }
+  return result;
+}
+
+// Разложение Лапласа по двум верхним строкам: 12 миноров 2x2 вместо
+// четырёх определителей 3x3
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::Determinant4() const {
+  const auto &m = matrix_;
+  double s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+  double s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+  double s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+  double s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+  double s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+  double s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+  double c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+  double c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+  double c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+  double c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+  double c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+  double c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+  return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+// Границы всех циклов известны при компиляции, и компилятор их
+// разворачивает. Обновляется только часть правее и ниже ведущего элемента.
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::LuDeterminant() const {
+  S21FixedMatrix a(*this);
+  double det = 1;
+  for (int k = 0; k < R; k++) {
+    int pivot = k;
+    double max = a.matrix_[k][k] < 0 ? -a.matrix_[k][k] : a.matrix_[k][k];
+    for (int i = k + 1; i < R; i++) {
+      double value = a.matrix_[i][k] < 0 ? -a.matrix_[i][k] : a.matrix_[i][k];
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    if (max == 0) return 0;
+    if (pivot != k) {
+      for (int j = k; j < C; j++) {
+        double tmp = a.matrix_[k][j];
+        a.matrix_[k][j] = a.matrix_[pivot][j];
+        a.matrix_[pivot][j] = tmp;
+      }
+      det = -det;
+    }
+    det *= a.matrix_[k][k];
+    double inv_pivot = 1 / a.matrix_[k][k];
+    for (int i = k + 1; i < R; i++) {
+      double l = a.matrix_[i][k] * inv_pivot;
+      for (int j = k + 1; j < C; j++) a.matrix_[i][j] -= l * a.matrix_[k][j];
+    }
+  }
+  return det;
+}
+
+// Дополнения через определители миноров: для мелких матриц это явная
+// формула, и она верна и для вырожденных матриц
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::CalcComplements() const {
+  static_assert(R == C, "S21FixedMatrix: complements need a square matrix");
+  S21FixedMatrix result;
+  if constexpr (R == 1) {
+    result.matrix_[0][0] = 1;
+  } else {
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) {
+        double minor = GetMinor(i, j).Determinant();
+        result.matrix_[i][j] = ((i + j) % 2) ? -minor : minor;
+      }
+  }
+  return result;
+}
+
+// Обратная матрица: до 4x4 - присоединённая матрица, делённая на
+// определитель, для больших - метод Гаусса-Жордана
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::InverseMatrix() const {
+  static_assert(R == C, "S21FixedMatrix: inverse needs a square matrix");
+  S21FixedMatrix result;
+  double det = 0;
+  if constexpr (R <= 4) {
+    det = Determinant();
+    if (det != 0) {
+      S21FixedMatrix complements = CalcComplements();
+      for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++)
+          result.matrix_[i][j] = complements.matrix_[j][i] / det;
+    }
+  } else {
+    det = GaussJordan(&result);
+  }
+  if (det == 0) {
+    throw std::out_of_range(
+        "Incorrect input: you can't inverse matrix if it's determinant is "
+        "equal to zero.");
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::GaussJordan(
+    S21FixedMatrix *inverse) const {
+  S21FixedMatrix a(*this), e;
+  for (int i = 0; i < R; i++) e.matrix_[i][i] = 1;
+
+  double det = 1;
+  for (int k = 0; k < R && det != 0; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < R; i++) {
+      double value = a.matrix_[i][k] < 0 ? -a.matrix_[i][k] : a.matrix_[i][k];
+      double max = a.matrix_[pivot][k] < 0 ? -a.matrix_[pivot][k]
+                                           : a.matrix_[pivot][k];
+      if (value > max) pivot = i;
+    }
+    if (a.matrix_[pivot][k] == 0) {
+      det = 0;
+      continue;
+    }
+    if (pivot != k) {
+      for (int j = 0; j < C; j++) {
+        double tmp = a.matrix_[k][j];
+        a.matrix_[k][j] = a.matrix_[pivot][j];
+        a.matrix_[pivot][j] = tmp;
+        tmp = e.matrix_[k][j];
+        e.matrix_[k][j] = e.matrix_[pivot][j];
+        e.matrix_[pivot][j] = tmp;
+      }
+      det = -det;
+    }
+    det *= a.matrix_[k][k];
+
+    // Для одного определителя достаточно обнулить элементы под диагональю
+    for (int i = inverse ? 0 : k + 1; i < R; i++) {
+      if (i == k) continue;
+      double factor = a.matrix_[i][k] / a.matrix_[k][k];
+      for (int j = 0; j < C; j++) {
+        a.matrix_[i][j] -= factor * a.matrix_[k][j];
+        e.matrix_[i][j] -= factor * e.matrix_[k][j];
+      }
+    }
+  }
+
+  if (inverse && det != 0) {
+    for (int i = 0; i < R; i++)
+      for (int j = 0; j < C; j++) e.matrix_[i][j] /= a.matrix_[i][i];
+    *inverse = e;
+  }
+  return det;
+}
+
+// ПРЕОБРАЗОВАНИЯ
+
+template <int R, int C>
+S21FixedMatrix<R, C>::S21FixedMatrix(const S21Matrix &other) : matrix_{} {
+  if (other.GetRows() != R || other.GetCols() != C) {
+    throw std::out_of_range(
+        "Incorrect input: matriсes should have the same size.");
+  }
+  for (int i = 0; i < R; i++)
+    std::memcpy(matrix_[i], other.Data() + (std::size_t)i * other.Stride(),
+                C * sizeof(double));
+}
+
+template <int R, int C>
+S21Matrix S21FixedMatrix<R, C>::ToMatrix() const {
+  S21Matrix result(R, C);
+  for (int i = 0; i < R; i++)
+    std::memcpy(result.WritableData() + (std::size_t)i * result.Stride(),
+                matrix_[i], C * sizeof(double));
+  return result;
+}
+
+#endif
@@ -0,0 +1,429 @@
+#include "s21_matrix_gemm.h"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "s21_matrix_thread_pool.h"
+
+namespace {
+
+// Размеры блоков: панель A (kMC x kKC) живёт в L2, панель B (kKC x kNC) - в
+// L3, полоска B (kKC x nr) и A (mr x kKC) - в L1. Размеры микроядра mr x nr
+// задаёт таблица ядер, kMC кратно всем вариантам mr.
+constexpr int kMC = 96;
+constexpr int kKC = 256;
+constexpr int kNC = 4096;
+
+// Ниже этого числа умножений упаковка не окупается
+constexpr long kSmallGemm = 32L * 32L * 32L;
+
+// Ниже этого числа умножений всё считается в вызывающем потоке
+constexpr long kParallelGemm = 128L * 128L * 128L;
+
+// Размер выходного тайла для многопоточного умножения (kMC x kTileN)
+constexpr int kTileN = 512;
+
+// GEMV с матрицей меньше этого числа элементов считается в вызывающем потоке
+constexpr long kParallelGemv = 1L << 16;
+
+// Блок столбцов одного потока в S21GemvT; более узкие матрицы делятся по
+// строкам
+constexpr int kGemvColumns = 512;
+
+constexpr std::size_t kAlignment = 64;
+
+// Переиспользуемый выровненный буфер для упакованных панелей (свой у
+// каждого потока, чтобы не выделять память на каждый вызов). Один буфер
+// обслуживает все типы элементов, размер хранится в байтах.
+class PackBuffer {
+ public:
+  PackBuffer() : data_(nullptr), size_(0) {}
+  PackBuffer(const PackBuffer &) = delete;
+  PackBuffer &operator=(const PackBuffer &) = delete;
+  ~PackBuffer() { Release(); }
+
+  template <class T>
+  T *Get(std::size_t count) {
+    std::size_t size = count * sizeof(T);
+    if (size > size_) {
+      Release();
+      data_ = ::operator new[](size, std::align_val_t(kAlignment));
+      size_ = size;
+    }
+    return static_cast<T *>(data_);
+  }
+
+ private:
+  void Release() {
+    if (data_) ::operator delete[](data_, std::align_val_t(kAlignment));
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  void *data_;
+  std::size_t size_;
+};
+
+thread_local PackBuffer a_buffer;
+thread_local PackBuffer b_buffer;
+
+// Упаковывает блок A (mc x kc) в полоски по k_mr строк: внутри полоски
+// элементы идут столбец за столбцом, недостающие строки дополняются нулями
+template <class T>
+void PackA(int mc, int kc, const T *a, int lda, int k_mr, T *packed) {
+  for (int i = 0; i < mc; i += k_mr) {
+    int mr = (mc - i < k_mr) ? mc - i : k_mr;
+    for (int p = 0; p < kc; p++) {
+      for (int r = 0; r < mr; r++)
+        packed[r] = a[(std::ptrdiff_t)(i + r) * lda + p];
+      for (int r = mr; r < k_mr; r++) packed[r] = 0;
+      packed += k_mr;
+    }
+  }
+}
+
+// Упаковывает блок B (kc x nc) в полоски по k_nr столбцов: внутри полоски
+// элементы идут строка за строкой, недостающие столбцы дополняются нулями
+template <class T>
+void PackB(int kc, int nc, const T *b, int ldb, int k_nr, T *packed) {
+  for (int j = 0; j < nc; j += k_nr) {
+    int nr = (nc - j < k_nr) ? nc - j : k_nr;
+    for (int p = 0; p < kc; p++) {
+      const T *row = b + (std::ptrdiff_t)p * ldb + j;
+      for (int s = 0; s < nr; s++) packed[s] = row[s];
+      for (int s = nr; s < k_nr; s++) packed[s] = 0;
+      packed += k_nr;
+    }
+  }
+}
+
+// Умножение маленьких матриц без упаковки, порядок i-k-j идёт по строкам
+template <class T>
+void SmallGemm(int m, int n, int k, const T *a, int lda, const T *b, int ldb,
+               T *c, int ldc, bool accumulate) {
+  for (int i = 0; i < m; i++) {
+    T *c_row = c + (std::ptrdiff_t)i * ldc;
+    if (!accumulate) std::memset(c_row, 0, n * sizeof(T));
+    for (int p = 0; p < k; p++) {
+      T a_ip = a[(std::ptrdiff_t)i * lda + p];
+      const T *b_row = b + (std::ptrdiff_t)p * ldb;
+      for (int j = 0; j < n; j++) c_row[j] += a_ip * b_row[j];
+    }
+  }
+}
+
+// Блочное умножение в одном потоке
+template <class T>
+void GemmSerial(const S21KernelsT<T> &kernels, int m, int n, int k, const T *a,
+                int lda, const T *b, int ldb, T *c, int ldc, bool accumulate) {
+  const int k_mr = kernels.gemm_mr, k_nr = kernels.gemm_nr;
+  int nc_max = (n < kNC) ? n : kNC;
+  int kc_max = (k < kKC) ? k : kKC;
+  int mc_max = (m < kMC) ? m : kMC;
+  T *packed_b = b_buffer.Get<T>(
+      (std::size_t)kc_max * ((nc_max + k_nr - 1) / k_nr * k_nr));
+  T *packed_a = a_buffer.Get<T>(
+      (std::size_t)kc_max * ((mc_max + k_mr - 1) / k_mr * k_mr));
+
+  for (int jc = 0; jc < n; jc += kNC) {
+    int nc = (n - jc < kNC) ? n - jc : kNC;
+    for (int pc = 0; pc < k; pc += kKC) {
+      int kc = (k - pc < kKC) ? k - pc : kKC;
+      // Первый проход по k перезаписывает C, остальные - накапливают
+      bool add = accumulate || pc > 0;
+      PackB(kc, nc, b + (std::ptrdiff_t)pc * ldb + jc, ldb, k_nr, packed_b);
+
+      for (int ic = 0; ic < m; ic += kMC) {
+        int mc = (m - ic < kMC) ? m - ic : kMC;
+        PackA(mc, kc, a + (std::ptrdiff_t)ic * lda + pc, lda, k_mr,
+              packed_a);
+
+        for (int jr = 0; jr < nc; jr += k_nr) {
+          int nr = (nc - jr < k_nr) ? nc - jr : k_nr;
+          for (int ir = 0; ir < mc; ir += k_mr) {
+            int mr = (mc - ir < k_mr) ? mc - ir : k_mr;
+            T *c_tile = c + (std::ptrdiff_t)(ic + ir) * ldc + jc + jr;
+            kernels.gemm(kc, packed_a + ir * kc, packed_b + jr * kc, c_tile,
+                         ldc, mr, nr, add);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+void S21Gemm(int m, int n, int k, const T *a, int lda, const T *b, int ldb,
+             T *c, int ldc, bool accumulate) {
+  S21Gemm(S21GetKernels<T>(), m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+template <class T>
+void S21Gemm(const S21KernelsT<T> &kernels, int m, int n, int k, const T *a,
+             int lda, const T *b, int ldb, T *c, int ldc, bool accumulate) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0) {
+    if (!accumulate)
+      for (int i = 0; i < m; i++)
+        std::memset(c + (std::ptrdiff_t)i * ldc, 0, n * sizeof(T));
+    return;
+  }
+
+  long flops = (long)m * n * k;
+  if (flops <= kSmallGemm) {
+    SmallGemm(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+  } else if (flops < kParallelGemm || S21GetNumThreads() == 1) {
+    GemmSerial(kernels, m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+  } else {
+    // Каждый поток считает свои тайлы C целиком и пакует панели сам
+    int tile_rows = (m + kMC - 1) / kMC;
+    int tile_cols = (n + kTileN - 1) / kTileN;
+    S21ThreadPool::Instance().ParallelFor(
+        0, tile_rows * tile_cols, 1, [&](int lo, int hi) {
+          for (int tile = lo; tile < hi; tile++) {
+            int i = tile / tile_cols * kMC, j = tile % tile_cols * kTileN;
+            int mc = (m - i < kMC) ? m - i : kMC;
+            int nc = (n - j < kTileN) ? n - j : kTileN;
+            GemmSerial(kernels, mc, nc, k, a + (std::ptrdiff_t)i * lda, lda,
+                       b + j, ldb, c + (std::ptrdiff_t)i * ldc + j, ldc,
+                       accumulate);
+          }
+        });
+  }
+}
+
+// GEMV
+
+template <class T>
+void S21Gemv(int m, int n, const T *a, int lda, const T *x, T *y) {
+  S21Gemv(S21GetKernels<T>(), m, n, a, lda, x, y);
+}
+
+// Каждая строка y считается целиком в одном потоке, поэтому результат не
+// зависит от деления на потоки
+template <class T>
+void S21Gemv(const S21KernelsT<T> &kernels, int m, int n, const T *a, int lda,
+             const T *x, T *y) {
+  if (m <= 0) return;
+  if (n <= 0) {
+    std::memset(y, 0, m * sizeof(T));
+  } else if ((long)m * n < kParallelGemv || S21GetNumThreads() == 1) {
+    kernels.gemv(a, lda, x, y, m, n);
+  } else {
+    int grain = (int)(kParallelGemv / n);
+    S21ThreadPool::Instance().ParallelFor(
+        0, m, grain < 4 ? 4 : grain, [&](int lo, int hi) {
+          kernels.gemv(a + (std::ptrdiff_t)lo * lda, lda, x, y + lo, hi - lo,
+                       n);
+        });
+  }
+}
+
+template <class T>
+void S21GemvT(int m, int n, const T *a, int lda, const T *x, T *y) {
+  S21GemvT(S21GetKernels<T>(), m, n, a, lda, x, y);
+}
+
+template <class T>
+void S21GemvT(const S21KernelsT<T> &kernels, int m, int n, const T *a,
+              int lda, const T *x, T *y) {
+  if (n <= 0) return;
+  std::memset(y, 0, n * sizeof(T));
+  if (m <= 0) return;
+
+  if ((long)m * n < kParallelGemv) {
+    kernels.gemv_t(a, lda, x, y, m, n);
+  } else if (n >= 2 * kGemvColumns) {
+    // Блоки столбцов не пересекаются по y
+    int blocks = (n + kGemvColumns - 1) / kGemvColumns;
+    S21ThreadPool::Instance().ParallelFor(0, blocks, 1, [&](int lo, int hi) {
+      int j0 = lo * kGemvColumns;
+      int j1 = (hi * kGemvColumns < n) ? hi * kGemvColumns : n;
+      kernels.gemv_t(a + j0, lda, x, y + j0, m, j1 - j0);
+    });
+  } else {
+    // Каждый блок строк копит свою сумму; суммы складываются по порядку
+    // блоков, поэтому результат одинаков при любом числе потоков
+    int chunk = (int)(kParallelGemv / n);
+    int chunks = (m + chunk - 1) / chunk;
+    std::vector<T> partial((std::size_t)chunks * n);
+    S21ThreadPool::Instance().ParallelFor(0, chunks, 1, [&](int lo, int hi) {
+      for (int c = lo; c < hi; c++) {
+        int i0 = c * chunk, rows = (m - i0 < chunk) ? m - i0 : chunk;
+        kernels.gemv_t(a + (std::ptrdiff_t)i0 * lda, lda, x + i0,
+                       partial.data() + (std::size_t)c * n, rows, n);
+      }
+    });
+    for (int c = 0; c < chunks; c++)
+      kernels.add(y, partial.data() + (std::size_t)c * n, n);
+  }
+}
+
+// ШТРАССЕН-ВИНОГРАД
+
+namespace {
+
+// Поэлементные операции с блоками с шагом строки; большие блоки делятся
+// между потоками по строкам
+constexpr long kParallelElements = 1L << 16;
+
+template <class T, class Op>
+void BlockOp(int rows, int cols, const T *x, int ldx, const T *y, int ldy,
+             T *z, int ldz, Op op) {
+  auto range = [&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+      const T *xi = x + (std::ptrdiff_t)i * ldx;
+      const T *yi = y + (std::ptrdiff_t)i * ldy;
+      T *zi = z + (std::ptrdiff_t)i * ldz;
+      for (int j = 0; j < cols; j++) zi[j] = op(xi[j], yi[j]);
+    }
+  };
+  if ((long)rows * cols < kParallelElements || S21GetNumThreads() == 1) {
+    range(0, rows);
+  } else {
+    int grain = (int)(kParallelElements / cols);
+    S21ThreadPool::Instance().ParallelFor(0, rows, grain < 1 ? 1 : grain,
+                                          range);
+  }
+}
+
+template <class T>
+void Add(int rows, int cols, const T *x, int ldx, const T *y, int ldy, T *z,
+         int ldz) {
+  BlockOp(rows, cols, x, ldx, y, ldy, z, ldz, [](T p, T q) { return p + q; });
+}
+
+template <class T>
+void Sub(int rows, int cols, const T *x, int ldx, const T *y, int ldy, T *z,
+         int ldz) {
+  BlockOp(rows, cols, x, ldx, y, ldy, z, ldz, [](T p, T q) { return p - q; });
+}
+
+// Шаг строки временных блоков: кратен kAlignment байтам
+template <class T>
+int PaddedLd(int cols) {
+  constexpr int kStep = kAlignment / sizeof(T);
+  return (cols + kStep - 1) / kStep * kStep;
+}
+
+bool IsLeaf(int m, int n, int k, int crossover) {
+  return m <= crossover || n <= crossover || k <= crossover || m < 2 ||
+         n < 2 || k < 2;
+}
+
+// Буфер одного уровня: X (m/2 x max(k/2, n/2)) и Y (k/2 x n/2), за ними -
+// буфер следующего уровня (все 7 произведений считаются по очереди и
+// используют его повторно)
+template <class T>
+std::size_t LevelWorkspace(int m, int n, int k, int crossover) {
+  if (IsLeaf(m, n, k, crossover)) return 0;
+  int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  std::size_t x = (std::size_t)m2 * PaddedLd<T>(k2 > n2 ? k2 : n2);
+  std::size_t y = (std::size_t)k2 * PaddedLd<T>(n2);
+  return x + y + LevelWorkspace<T>(m2, n2, k2, crossover);
+}
+
+// Один уровень по расписанию Бойера-Дюма-Пернэ-Чжоу: два временных блока
+// X и Y, произведения P1..P7 пишутся прямо в четверти C
+template <class T>
+void Strassen(int m, int n, int k, const T *a, int lda, const T *b, int ldb,
+              T *c, int ldc, int crossover, T *work) {
+  if (IsLeaf(m, n, k, crossover)) {
+    S21Gemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const T *a11 = a, *a12 = a + k2;
+  const T *a21 = a + (std::ptrdiff_t)m2 * lda, *a22 = a21 + k2;
+  const T *b11 = b, *b12 = b + n2;
+  const T *b21 = b + (std::ptrdiff_t)k2 * ldb, *b22 = b21 + n2;
+  T *c11 = c, *c12 = c + n2;
+  T *c21 = c + (std::ptrdiff_t)m2 * ldc, *c22 = c21 + n2;
+
+  const int ldx = PaddedLd<T>(k2 > n2 ? k2 : n2), ldy = PaddedLd<T>(n2);
+  T *x = work, *y = work + (std::size_t)m2 * ldx;
+  T *next = y + (std::size_t)k2 * ldy;
+  auto mul = [&](const T *p, int ldp, const T *q, int ldq, T *r, int ldr) {
+    Strassen(m2, n2, k2, p, ldp, q, ldq, r, ldr, crossover, next);
+  };
+
+  Sub(m2, k2, a11, lda, a21, lda, x, ldx);  // S3 = A11 - A21
+  Sub(k2, n2, b22, ldb, b12, ldb, y, ldy);  // T3 = B22 - B12
+  mul(x, ldx, y, ldy, c21, ldc);            // P7 = S3 * T3
+  Add(m2, k2, a21, lda, a22, lda, x, ldx);  // S1 = A21 + A22
+  Sub(k2, n2, b12, ldb, b11, ldb, y, ldy);  // T1 = B12 - B11
+  mul(x, ldx, y, ldy, c22, ldc);            // P5 = S1 * T1
+  Sub(m2, k2, x, ldx, a11, lda, x, ldx);    // S2 = S1 - A11
+  Sub(k2, n2, b22, ldb, y, ldy, y, ldy);    // T2 = B22 - T1
+  mul(x, ldx, y, ldy, c12, ldc);            // P6 = S2 * T2
+  Sub(m2, k2, a12, lda, x, ldx, x, ldx);    // S4 = A12 - S2
+  mul(x, ldx, b22, ldb, c11, ldc);          // P3 = S4 * B22
+  mul(a11, lda, b11, ldb, x, ldx);          // P1 = A11 * B11
+  Add(m2, n2, x, ldx, c12, ldc, c12, ldc);  // U2 = P1 + P6
+  Add(m2, n2, c12, ldc, c21, ldc, c21, ldc);  // U3 = U2 + P7
+  Add(m2, n2, c12, ldc, c22, ldc, c12, ldc);  // U4 = U2 + P5
+  Add(m2, n2, c21, ldc, c22, ldc, c22, ldc);  // C22 = U3 + P5
+  Add(m2, n2, c12, ldc, c11, ldc, c12, ldc);  // C12 = U4 + P3
+  Sub(k2, n2, y, ldy, b21, ldb, y, ldy);      // T4 = T2 - B21
+  mul(a22, lda, y, ldy, c11, ldc);            // P4 = A22 * T4
+  Sub(m2, n2, c21, ldc, c11, ldc, c21, ldc);  // C21 = U3 - P4
+  mul(a12, lda, b21, ldb, c11, ldc);          // P2 = A12 * B21
+  Add(m2, n2, x, ldx, c11, ldc, c11, ldc);    // C11 = P1 + P2
+
+  // Отщеплённые нечётные строка, столбец и слагаемое по k
+  const int me = 2 * m2, ne = 2 * n2, ke = 2 * k2;
+  if (ke < k)
+    S21Gemm(me, ne, k - ke, a + ke, lda, b + (std::ptrdiff_t)ke * ldb, ldb, c,
+            ldc, true);
+  if (ne < n) S21Gemm(me, n - ne, k, a, lda, b + ne, ldb, c + ne, ldc);
+  if (me < m)
+    S21Gemm(m - me, n, k, a + (std::ptrdiff_t)me * lda, lda, b, ldb,
+            c + (std::ptrdiff_t)me * ldc, ldc);
+}
+
+}  // namespace
+
+template <class T>
+std::size_t S21StrassenWorkspace(int m, int n, int k, int crossover) {
+  return LevelWorkspace<T>(m, n, k, crossover);
+}
+
+template <class T>
+void S21StrassenGemm(int m, int n, int k, const T *a, int lda, const T *b,
+                     int ldb, T *c, int ldc, int crossover, T *workspace) {
+  if (crossover < 1) crossover = 1;
+  if (m <= 0 || n <= 0 || k <= 0 || IsLeaf(m, n, k, crossover)) {
+    S21Gemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  PackBuffer owned;
+  if (!workspace)
+    workspace = owned.Get<T>(LevelWorkspace<T>(m, n, k, crossover));
+  Strassen(m, n, k, a, lda, b, ldb, c, ldc, crossover, workspace);
+}
+
+// Явные инстанцирования для поддерживаемых типов элементов
+#define S21_GEMM_INSTANTIATE(T)                                               \
+  template void S21Gemm(int, int, int, const T *, int, const T *, int, T *,  \
+                        int, bool);                                          \
+  template void S21Gemm(const S21KernelsT<T> &, int, int, int, const T *,    \
+                        int, const T *, int, T *, int, bool);                \
+  template void S21Gemv(int, int, const T *, int, const T *, T *);            \
+  template void S21Gemv(const S21KernelsT<T> &, int, int, const T *, int,    \
+                        const T *, T *);                                     \
+  template void S21GemvT(int, int, const T *, int, const T *, T *);          \
+  template void S21GemvT(const S21KernelsT<T> &, int, int, const T *, int,   \
+                         const T *, T *);                                    \
+  template std::size_t S21StrassenWorkspace<T>(int, int, int, int);          \
+  template void S21StrassenGemm(int, int, int, const T *, int, const T *,    \
+                                int, T *, int, int, T *);
+
+S21_GEMM_INSTANTIATE(float)
+S21_GEMM_INSTANTIATE(double)
+S21_GEMM_INSTANTIATE(long double)
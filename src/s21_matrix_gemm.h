@@ -0,0 +1,75 @@
+#ifndef __S21MATRIX_GEMM_H__
+#define __S21MATRIX_GEMM_H__
+
+#include <cstddef>
+
+#include "s21_matrix_kernels.h"
+
+// Ядро умножения матриц (GEMM) с блокировкой под кэши L1/L2/L3, упаковкой
+// панелей A и B и регистровым микроядром.
+//
+// Все матрицы хранятся построчно, ld* - шаг строки в элементах.
+// Вычисляет C = A * B (или C += A * B, если accumulate == true),
+// где A - m x k, B - k x n, C - m x n. Определено для float, double и
+// long double, у каждого типа свои микроядра (s21_matrix_kernels.h).
+template <class T>
+void S21Gemm(int m, int n, int k, const T *a, int lda, const T *b, int ldb,
+             T *c, int ldc, bool accumulate = false);
+
+// То же с явно заданной таблицей ядер (для тестов и сравнения наборов
+// инструкций)
+template <class T>
+void S21Gemm(const S21KernelsT<T> &kernels, int m, int n, int k, const T *a,
+             int lda, const T *b, int ldb, T *c, int ldc,
+             bool accumulate = false);
+
+// Умножение матрицы на вектор (GEMV): y = A x, где A - m x n, x - n
+// элементов, y - m. Векторы непрерывные. Большие матрицы делятся между
+// потоками по строкам.
+template <class T>
+void S21Gemv(int m, int n, const T *a, int lda, const T *x, T *y);
+template <class T>
+void S21Gemv(const S21KernelsT<T> &kernels, int m, int n, const T *a, int lda,
+             const T *x, T *y);
+
+// Вектор на матрицу: y^T = x^T A, где x - m элементов, y - n. Широкие
+// матрицы делятся между потоками по блокам столбцов, высокие и узкие - по
+// блокам строк с частичными суммами. Порядок сложений зависит только от
+// размеров, а не от числа потоков.
+template <class T>
+void S21GemvT(int m, int n, const T *a, int lda, const T *x, T *y);
+template <class T>
+void S21GemvT(const S21KernelsT<T> &kernels, int m, int n, const T *a,
+              int lda, const T *x, T *y);
+
+// Быстрое умножение Штрассена-Винограда: 7 умножений блоков вдвое меньшего
+// размера вместо 8 на каждом уровне рекурсии. Блоки, у которых хотя бы одна
+// размерность не больше crossover, умножаются обычным S21Gemm. Нечётные
+// размерности обрабатываются отщеплением последней строки (столбца): чётная
+// часть идёт в рекурсию, остаток досчитывается тонкими произведениями.
+//
+// Погрешность выше, чем у обычного умножения (слагаемые вычитаются до
+// умножения), но того же порядка для хорошо обусловленных данных.
+constexpr int kS21StrassenCrossover = 1024;
+
+// Автоматический выбор (S21MulPolicy::kAuto) включает Штрассена, когда все
+// размерности не меньше этого порога: при 2048 один уровень рекурсии уже
+// выигрывает около 10%, при 4096 - около 15%
+constexpr int kS21StrassenMinSize = 2048;
+
+// Рабочий буфер для S21StrassenGemm в элементах T: все уровни рекурсии
+// работают в одном буфере, который выделяется один раз
+template <class T = double>
+std::size_t S21StrassenWorkspace(int m, int n, int k,
+                                 int crossover = kS21StrassenCrossover);
+
+// C = A * B (без накопления). workspace - буфер не меньше
+// S21StrassenWorkspace(m, n, k, crossover) элементов или nullptr, тогда
+// буфер выделяется на время вызова.
+template <class T>
+void S21StrassenGemm(int m, int n, int k, const T *a, int lda, const T *b,
+                     int ldb, T *c, int ldc,
+                     int crossover = kS21StrassenCrossover,
+                     T *workspace = nullptr);
+
+#endif
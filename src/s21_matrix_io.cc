@@ -0,0 +1,296 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// Закрывает дескриптор файла при выходе из области видимости
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) : fd_(fd) {}
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+  ~FileDescriptor() {
+    if (fd_ >= 0) close(fd_);
+  }
+
+  int Get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+std::runtime_error SystemError(const std::string &what,
+                               const std::string &path) {
+  return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+std::runtime_error FormatError(const std::string &what,
+                               const std::string &path) {
+  return std::runtime_error("Incorrect matrix file '" + path + "': " + what);
+}
+
+// Создаёт рядом с path новый файл с уникальным именем. В отличие от mkstemp
+// (права 0600) права 0666 ограничиваются umask, как у обычного файла.
+int CreateTempFile(const std::string &path, std::string *temp_path) {
+  static std::atomic<unsigned> counter{0};
+  int fd = -1;
+  do {
+    *temp_path = path + "." + std::to_string(getpid()) + "." +
+                 std::to_string(counter++) + ".tmp";
+    fd = open(temp_path->c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+              0666);
+  } while (fd < 0 && errno == EEXIST);
+  return fd;
+}
+
+// Отображение файла в память, которое служит буфером матрицы. Распределитель
+// владеет отображением и уничтожает себя, когда матрица возвращает буфер.
+class MappedFile : public S21MatrixAllocator {
+ public:
+  explicit MappedFile(bool writable)
+      : base_(nullptr), length_(0), writable_(writable) {}
+  ~MappedFile() override {
+    if (base_) munmap(base_, length_);
+  }
+
+  // Отображает первые length байт файла; при writable изменения остаются
+  // личными для процесса (копирование при записи)
+  char *Map(int fd, std::size_t length, const std::string &path) {
+    int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *base = mmap(nullptr, length, prot, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) throw SystemError("Can't map file", path);
+    base_ = base;
+    length_ = length;
+    return static_cast<char *>(base);
+  }
+
+  // Новые буферы отображение не выдаёт: матрица берёт его готовый буфер
+  void *Allocate(std::size_t) override { throw std::bad_alloc(); }
+  void Deallocate(void *, std::size_t) override { delete this; }
+  bool Writable() const override { return writable_; }
+
+ private:
+  void *base_;
+  std::size_t length_;
+  bool writable_;
+};
+
+}  // namespace
+
+void S21ReadExact(int fd, void *data, std::size_t bytes, std::int64_t offset,
+                  const std::string &path) {
+  char *dst = static_cast<char *>(data);
+  while (bytes > 0) {
+    ssize_t done = pread(fd, dst, bytes, (off_t)offset);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) throw SystemError("Can't read file", path);
+    if (done == 0) throw FormatError("unexpected end of file", path);
+    dst += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+void S21WriteExact(int fd, const void *data, std::size_t bytes,
+                   std::int64_t offset, const std::string &path) {
+  const char *src = static_cast<const char *>(data);
+  while (bytes > 0) {
+    ssize_t done = pwrite(fd, src, bytes, (off_t)offset);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) throw SystemError("Can't write file", path);
+    src += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+std::size_t S21MatrixDtypeSize(std::uint32_t dtype) {
+  switch (dtype) {
+    case kS21MatrixDtypeFloat64:
+      return sizeof(double);
+    case kS21MatrixDtypeFloat32:
+      return sizeof(float);
+    case kS21MatrixDtypeLongDouble:
+      return sizeof(long double);
+    default:
+      return 0;
+  }
+}
+
+S21MatrixFileHeader S21MakeMatrixHeader(int rows, int cols, int stride,
+                                        std::uint32_t dtype) {
+  S21MatrixFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kS21MatrixMagic, sizeof(header.magic));
+  header.version = kS21MatrixFileVersion;
+  header.dtype = dtype;
+  header.byte_order = kS21MatrixByteOrder;
+  header.data_offset = sizeof(S21MatrixFileHeader);
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.data_bytes =
+      (std::uint64_t)rows * stride * S21MatrixDtypeSize(dtype);
+  return header;
+}
+
+S21MatrixFileHeader S21ReadMatrixHeader(int fd, const std::string &path,
+                                        std::uint32_t dtype) {
+  S21MatrixFileHeader header;
+  S21ReadExact(fd, &header, sizeof(header), 0, path);
+
+  if (std::memcmp(header.magic, kS21MatrixMagic, sizeof(header.magic)) != 0)
+    throw FormatError("not a matrix file", path);
+  if (header.version != kS21MatrixFileVersion)
+    throw FormatError("unsupported version", path);
+  if (header.dtype != dtype) {
+    throw FormatError(S21MatrixDtypeSize(header.dtype)
+                          ? "element type differs from the matrix type"
+                          : "unsupported element type",
+                      path);
+  }
+  const std::size_t element = S21MatrixDtypeSize(dtype);
+  if (header.byte_order != kS21MatrixByteOrder)
+    throw FormatError("unsupported byte order", path);
+  if (header.data_offset < sizeof(header) ||
+      header.data_offset % element != 0)
+    throw FormatError("bad data offset", path);
+  if (header.rows <= 0 || header.rows > INT_MAX || header.cols <= 0 ||
+      header.cols > INT_MAX || header.stride < header.cols ||
+      header.stride > INT_MAX)
+    throw FormatError("bad matrix size", path);
+  // rows * stride * element доходит до 2^66 и в uint64 может обернуться
+  // ровно в data_bytes из поддельного заголовка, поэтому переполнение
+  // проверяется явно
+  std::uint64_t data_bytes = 0, file_bytes = 0;
+  if (__builtin_mul_overflow((std::uint64_t)header.rows,
+                             (std::uint64_t)header.stride, &data_bytes) ||
+      __builtin_mul_overflow(data_bytes, (std::uint64_t)element,
+                             &data_bytes) ||
+      header.data_bytes != data_bytes ||
+      (std::uint64_t)(std::size_t)data_bytes != data_bytes ||
+      __builtin_add_overflow(data_bytes, (std::uint64_t)header.data_offset,
+                             &file_bytes) ||
+      (std::uint64_t)(std::size_t)file_bytes != file_bytes)
+    throw FormatError("bad data size", path);
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) throw SystemError("Can't stat file", path);
+  if ((std::uint64_t)info.st_size < file_bytes)
+    throw FormatError("file is truncated", path);
+
+  return header;
+}
+
+// Заголовок и весь буфер (вместе с выравнивающими хвостами строк) уходят
+// одним вызовом writev; цикл нужен только при частичной записи. Файл пишется
+// под временным именем и затем переименовывается: отображения старого файла
+// (в том числе буфер этой же матрицы) остаются целыми.
+template <class T>
+void S21MatrixT<T>::Save(const std::string &path) const {
+  S21_STATS_SCOPE(kSave, rows_, cols_, 0);
+  S21MatrixFileHeader header = S21MakeMatrixHeader(rows_, cols_, stride_,
+                                                   S21MatrixDtype<T>::value);
+  std::string temp_path;
+  FileDescriptor file(CreateTempFile(path, &temp_path));
+  if (file.Get() < 0) throw SystemError("Can't create file", path);
+
+  iovec parts[2] = {{&header, sizeof(header)},
+                    {matrix_, (std::size_t)header.data_bytes}};
+  int first = 0;
+  while (first < 2) {
+    ssize_t done = writev(file.Get(), parts + first, 2 - first);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) {
+      unlink(temp_path.c_str());
+      throw SystemError("Can't write file", path);
+    }
+    while (first < 2 && (std::size_t)done >= parts[first].iov_len) {
+      done -= parts[first].iov_len;
+      first++;
+    }
+    if (first < 2) {
+      parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + done;
+      parts[first].iov_len -= done;
+    }
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    unlink(temp_path.c_str());
+    throw SystemError("Can't write file", path);
+  }
+}
+
+// Отображение возможно, только если шаг строки в файле совпадает с нашим;
+// иначе (и в режиме kCopy) данные читаются в новый буфер. Хвосты строк
+// отображения не проверяются, чтобы не читать весь файл: их обнуляет копия
+// при первом изменении (kMapReadOnly) или EditSize при росте
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::Load(const std::string &path, S21LoadMode mode) {
+  FileDescriptor file(open(path.c_str(), O_RDONLY));
+  if (file.Get() < 0) throw SystemError("Can't open file", path);
+  S21MatrixFileHeader header =
+      S21ReadMatrixHeader(file.Get(), path, S21MatrixDtype<T>::value);
+  int rows = (int)header.rows, cols = (int)header.cols;
+  S21_STATS_SCOPE(kLoad, rows, cols, 0);
+  bool same_stride = header.stride == PaddedStride(cols);
+
+  S21MatrixT result(1, 1);
+  if (mode != S21LoadMode::kCopy && same_stride &&
+      header.data_offset % kAlignment == 0) {
+    std::unique_ptr<MappedFile> mapping(
+        new MappedFile(mode == S21LoadMode::kMapPrivate));
+    char *base = mapping->Map(
+        file.Get(), header.data_offset + header.data_bytes, path);
+
+    result.Free();
+    result.rows_ = rows;
+    result.cols_ = cols;
+    result.stride_ = (int)header.stride;
+    result.capacity_rows_ = rows;
+    result.matrix_ = reinterpret_cast<T *>(base + header.data_offset);
+    result.allocator_ = mapping.release();
+    // Отображение учитывается как буфер: Free вернёт его как обычный
+    S21_STATS_ALLOCATION(header.data_bytes);
+  } else if (same_stride) {
+    // Хвосты строк в файле могут быть любыми, в матрице они - нули
+    result = S21MatrixT(rows, cols);
+    S21ReadExact(file.Get(), result.matrix_, header.data_bytes,
+                 header.data_offset, path);
+    result.ZeroPadding();
+  } else {
+    result = S21MatrixT(rows, cols);
+    for (int i = 0; i < rows; i++) {
+      off_t offset =
+          header.data_offset + (off_t)i * header.stride * sizeof(T);
+      S21ReadExact(file.Get(), &result.At(i, 0), cols * sizeof(T), offset,
+                   path);
+    }
+  }
+
+  return result;
+}
+
+template void S21MatrixT<float>::Save(const std::string &) const;
+template void S21MatrixT<double>::Save(const std::string &) const;
+template void S21MatrixT<long double>::Save(const std::string &) const;
+template S21MatrixT<float> S21MatrixT<float>::Load(const std::string &,
+                                                   S21LoadMode);
+template S21MatrixT<double> S21MatrixT<double>::Load(const std::string &,
+                                                     S21LoadMode);
+template S21MatrixT<long double> S21MatrixT<long double>::Load(
+    const std::string &, S21LoadMode);
@@ -0,0 +1,79 @@
+#ifndef __S21MATRIX_IO_H__
+#define __S21MATRIX_IO_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Двоичный формат файла матрицы (S21Matrix::Save / S21Matrix::Load).
+//
+// Файл - заголовок S21MatrixFileHeader (64 байта), за которым сразу идут
+// данные: rows строк по stride элементов типа dtype в порядке байтов машины.
+// Данные начинаются со смещения 64, поэтому при отображении файла в память
+// они выровнены так же, как буфер S21Matrix, и используются без копирования.
+// Элементы строки за cols (выравнивающий хвост) значимыми не считаются:
+// Load обнуляет их при чтении в буфер и при копировании отображения.
+struct S21MatrixFileHeader {
+  char magic[8];          // kS21MatrixMagic
+  std::uint32_t version;  // kS21MatrixFileVersion
+  std::uint32_t dtype;    // Тип элементов, kS21MatrixDtype*
+  std::uint32_t byte_order;  // kS21MatrixByteOrder в порядке байтов записи
+  std::uint32_t data_offset;  // Смещение данных от начала файла
+  std::int64_t rows;
+  std::int64_t cols;
+  std::int64_t stride;         // Шаг строки в элементах
+  std::uint64_t data_bytes;    // rows * stride * размер элемента
+  std::uint64_t reserved;
+};
+
+static_assert(sizeof(S21MatrixFileHeader) == 64,
+              "S21MatrixFileHeader should take exactly 64 bytes");
+
+constexpr char kS21MatrixMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kS21MatrixFileVersion = 1;
+constexpr std::uint32_t kS21MatrixDtypeFloat64 = 1;
+constexpr std::uint32_t kS21MatrixDtypeFloat32 = 2;
+// long double в формате машины (на x86-64 - 80 бит x87 в 16 байтах)
+constexpr std::uint32_t kS21MatrixDtypeLongDouble = 3;
+constexpr std::uint32_t kS21MatrixByteOrder = 0x01020304;
+
+// Код типа элементов для S21MatrixT<T>
+template <class T>
+struct S21MatrixDtype;
+template <>
+struct S21MatrixDtype<double> {
+  static constexpr std::uint32_t value = kS21MatrixDtypeFloat64;
+};
+template <>
+struct S21MatrixDtype<float> {
+  static constexpr std::uint32_t value = kS21MatrixDtypeFloat32;
+};
+template <>
+struct S21MatrixDtype<long double> {
+  static constexpr std::uint32_t value = kS21MatrixDtypeLongDouble;
+};
+
+// Размер элемента типа dtype в байтах (0 для неизвестного типа)
+std::size_t S21MatrixDtypeSize(std::uint32_t dtype);
+
+// Заголовок для матрицы rows x cols с шагом строки stride
+S21MatrixFileHeader S21MakeMatrixHeader(
+    int rows, int cols, int stride,
+    std::uint32_t dtype = kS21MatrixDtypeFloat64);
+
+// Читает заголовок из начала открытого файла и проверяет его: сигнатуру,
+// версию, тип (должен быть dtype), порядок байтов и размеры относительно
+// размера файла. При ошибке бросает std::runtime_error; path нужен только
+// для сообщения.
+S21MatrixFileHeader S21ReadMatrixHeader(
+    int fd, const std::string &path,
+    std::uint32_t dtype = kS21MatrixDtypeFloat64);
+
+// Читают и пишут ровно bytes байт со смещения offset, повторяя частичные
+// операции; при ошибке бросают std::runtime_error
+void S21ReadExact(int fd, void *data, std::size_t bytes, std::int64_t offset,
+                  const std::string &path);
+void S21WriteExact(int fd, const void *data, std::size_t bytes,
+                   std::int64_t offset, const std::string &path);
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef __S21MATRIX_ITERATOR_H__
+#define __S21MATRIX_ITERATOR_H__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Итераторы по элементам и строкам матрицы (S21MatrixT::begin(),
+// S21MatrixT::RowSpans()) и отрезок строки S21SpanT.
+//
+// Итераторы обходят элементы построчно и пропускают выравнивающие хвосты
+// строк. Они действительны, пока не меняется размер матрицы, как и
+// представления (s21_matrix_view.h). T может быть const - тогда элементы
+// доступны только для чтения.
+
+// Непрерывный отрезок элементов - строка матрицы. Имена методов как у
+// std::span из C++20, чтобы отрезок подходил для range-for и алгоритмов
+// стандартной библиотеки.
+template <class T>
+class S21SpanT {
+ public:
+  using element_type = T;
+  using value_type = std::remove_const_t<T>;
+  using iterator = T *;
+
+  S21SpanT(T *data, int size) : data_(data), size_(size) {}
+  template <class U, class = std::enable_if_t<std::is_same<const U, T>::value &&
+                                              !std::is_same<U, T>::value>>
+  S21SpanT(const S21SpanT<U> &other) : S21SpanT(other.data(), other.size()) {}
+
+  T *data() const { return data_; }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T &operator[](int i) const { return data_[i]; }  // Без проверки границ
+  T *begin() const { return data_; }
+  T *end() const { return data_ + size_; }
+
+ private:
+  T *data_;
+  int size_;
+};
+
+// Итератор произвольного доступа по элементам. Хранит указатель на начало
+// текущей строки и номер столбца, поэтому ++ и * не делят индекс на число
+// столбцов; деление нужно только при переходе на n элементов.
+template <class T>
+class S21MatrixIteratorT {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_const_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
+  S21MatrixIteratorT() : row_(nullptr), y_(0), x_(0), cols_(0), stride_(0) {}
+  // Итератор на элемент (y, x) матрицы с первым элементом data
+  S21MatrixIteratorT(T *data, int cols, int stride, int y, int x)
+      : row_(data + (std::ptrdiff_t)y * stride),
+        y_(y),
+        x_(x),
+        cols_(cols),
+        stride_(stride) {}
+  template <class U, class = std::enable_if_t<std::is_same<const U, T>::value &&
+                                              !std::is_same<U, T>::value>>
+  S21MatrixIteratorT(const S21MatrixIteratorT<U> &other)
+      : row_(other.row_),
+        y_(other.y_),
+        x_(other.x_),
+        cols_(other.cols_),
+        stride_(other.stride_) {}
+
+  reference operator*() const { return row_[x_]; }
+  pointer operator->() const { return row_ + x_; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  S21MatrixIteratorT &operator++() {
+    if (++x_ == cols_) {
+      x_ = 0;
+      y_++;
+      row_ += stride_;
+    }
+    return *this;
+  }
+  S21MatrixIteratorT &operator--() {
+    if (x_ == 0) {
+      x_ = cols_;
+      y_--;
+      row_ -= stride_;
+    }
+    x_--;
+    return *this;
+  }
+  S21MatrixIteratorT operator++(int) {
+    S21MatrixIteratorT old = *this;
+    ++*this;
+    return old;
+  }
+  S21MatrixIteratorT operator--(int) {
+    S21MatrixIteratorT old = *this;
+    --*this;
+    return old;
+  }
+
+  // У итератора по умолчанию и у итератора пустой матрицы нет столбцов:
+  // сдвигать его некуда
+  S21MatrixIteratorT &operator+=(difference_type n) {
+    if (n != 0 && cols_ != 0) {
+      difference_type index = Index() + n;
+      int y = (int)(index / cols_);
+      row_ += (std::ptrdiff_t)(y - y_) * stride_;
+      y_ = y;
+      x_ = (int)(index % cols_);
+    }
+    return *this;
+  }
+  S21MatrixIteratorT &operator-=(difference_type n) { return *this += -n; }
+  friend S21MatrixIteratorT operator+(S21MatrixIteratorT it,
+                                      difference_type n) {
+    return it += n;
+  }
+  friend S21MatrixIteratorT operator+(difference_type n,
+                                      S21MatrixIteratorT it) {
+    return it += n;
+  }
+  friend S21MatrixIteratorT operator-(S21MatrixIteratorT it,
+                                      difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const S21MatrixIteratorT &a,
+                                   const S21MatrixIteratorT &b) {
+    return a.Index() - b.Index();
+  }
+
+  friend bool operator==(const S21MatrixIteratorT &a,
+                         const S21MatrixIteratorT &b) {
+    return a.y_ == b.y_ && a.x_ == b.x_;
+  }
+  friend bool operator!=(const S21MatrixIteratorT &a,
+                         const S21MatrixIteratorT &b) {
+    return !(a == b);
+  }
+  friend bool operator<(const S21MatrixIteratorT &a,
+                        const S21MatrixIteratorT &b) {
+    return a.Index() < b.Index();
+  }
+  friend bool operator>(const S21MatrixIteratorT &a,
+                        const S21MatrixIteratorT &b) {
+    return b < a;
+  }
+  friend bool operator<=(const S21MatrixIteratorT &a,
+                         const S21MatrixIteratorT &b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const S21MatrixIteratorT &a,
+                         const S21MatrixIteratorT &b) {
+    return !(a < b);
+  }
+
+ private:
+  template <class U>
+  friend class S21MatrixIteratorT;
+
+  difference_type Index() const { return (difference_type)y_ * cols_ + x_; }
+
+  T *row_;  // Начало текущей строки
+  int y_, x_;
+  int cols_;
+  int stride_;
+};
+
+// Итератор по строкам: разыменование даёт S21SpanT строки
+template <class T>
+class S21RowIteratorT {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = S21SpanT<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = S21SpanT<T>;  // Отрезок возвращается по значению
+
+  S21RowIteratorT() : row_(nullptr), cols_(0), stride_(0) {}
+  S21RowIteratorT(T *row, int cols, int stride)
+      : row_(row), cols_(cols), stride_(stride) {}
+
+  reference operator*() const { return S21SpanT<T>(row_, cols_); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  S21RowIteratorT &operator++() { return *this += 1; }
+  S21RowIteratorT &operator--() { return *this -= 1; }
+  S21RowIteratorT operator++(int) {
+    S21RowIteratorT old = *this;
+    ++*this;
+    return old;
+  }
+  S21RowIteratorT operator--(int) {
+    S21RowIteratorT old = *this;
+    --*this;
+    return old;
+  }
+  S21RowIteratorT &operator+=(difference_type n) {
+    row_ += n * stride_;
+    return *this;
+  }
+  S21RowIteratorT &operator-=(difference_type n) { return *this += -n; }
+  friend S21RowIteratorT operator+(S21RowIteratorT it, difference_type n) {
+    return it += n;
+  }
+  friend S21RowIteratorT operator+(difference_type n, S21RowIteratorT it) {
+    return it += n;
+  }
+  friend S21RowIteratorT operator-(S21RowIteratorT it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const S21RowIteratorT &a,
+                                   const S21RowIteratorT &b) {
+    return a.stride_ ? (a.row_ - b.row_) / a.stride_ : 0;
+  }
+
+  friend bool operator==(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return a.row_ == b.row_;
+  }
+  friend bool operator!=(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return a.row_ != b.row_;
+  }
+  friend bool operator<(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return a.row_ < b.row_;
+  }
+  friend bool operator>(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return b < a;
+  }
+  friend bool operator<=(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return !(b < a);
+  }
+  friend bool operator>=(const S21RowIteratorT &a, const S21RowIteratorT &b) {
+    return !(a < b);
+  }
+
+ private:
+  T *row_;
+  int cols_;
+  int stride_;
+};
+
+// Диапазон строк для range-for: for (S21Span row : matrix.RowSpans())
+template <class T>
+class S21RowRangeT {
+ public:
+  S21RowRangeT(T *data, int rows, int cols, int stride)
+      : begin_(data, cols, stride),
+        end_(data + (std::ptrdiff_t)rows * stride, cols, stride) {}
+
+  S21RowIteratorT<T> begin() const { return begin_; }
+  S21RowIteratorT<T> end() const { return end_; }
+  int size() const { return (int)(end_ - begin_); }
+
+ private:
+  S21RowIteratorT<T> begin_, end_;
+};
+
+using S21Span = S21SpanT<double>;
+using S21ConstSpan = S21SpanT<const double>;
+
+#endif
@@ -0,0 +1,1224 @@
+#include "s21_matrix_kernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// СКАЛЯРНЫЕ ЯДРА (работают на любой платформе и с любым типом элементов)
+
+template <class T>
+void AddScalar(T *dst, const T *src, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] += src[i];
+}
+
+template <class T>
+void SubScalar(T *dst, const T *src, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] -= src[i];
+}
+
+template <class T>
+void ScaleScalar(T *dst, T num, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] *= num;
+}
+
+template <class T>
+void ZeroScalar(T *dst, std::size_t n) {
+  if (n != 0) std::memset(dst, 0, n * sizeof(T));
+}
+
+template <class T>
+bool EqualScalar(const T *a, const T *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++)
+    if (a[i] != b[i]) return false;
+  return true;
+}
+
+// Транспонирует прямоугольник [i0, rows) x [j0, cols) без векторизации.
+// Векторные ядра обрабатывают квадраты B x B, а остатки с краёв - этой
+// функцией: прямоугольник справа [0, rows) x [j0, cols) и снизу
+// [i0, rows) x [0, j0).
+template <class T>
+void TransposeEdge(const T *src, int lds, T *dst, int ldd, int rows, int cols,
+                   int i0, int j0) {
+  for (int i = 0; i < rows; i++) {
+    for (int j = (i < i0) ? j0 : 0; j < cols; j++)
+      dst[(std::ptrdiff_t)j * ldd + i] = src[(std::ptrdiff_t)i * lds + j];
+  }
+}
+
+template <class T>
+void TransposeScalar(const T *src, int lds, T *dst, int ldd, int rows,
+                     int cols) {
+  TransposeEdge(src, lds, dst, ldd, rows, cols, 0, 0);
+}
+
+// Матрица на вектор: y[i] = a[i, :] * x
+template <class T>
+void GemvScalar(const T *a, int lda, const T *x, T *y, int rows, int cols) {
+  for (int i = 0; i < rows; i++) {
+    const T *row = a + (std::ptrdiff_t)i * lda;
+    T sum = 0;
+    for (int j = 0; j < cols; j++) sum += row[j] * x[j];
+    y[i] = sum;
+  }
+}
+
+// Вектор на матрицу: y[j] += x[i] * a[i, j]
+template <class T>
+void GemvTScalar(const T *a, int lda, const T *x, T *y, int rows, int cols) {
+  for (int i = 0; i < rows; i++) {
+    const T *row = a + (std::ptrdiff_t)i * lda;
+    for (int j = 0; j < cols; j++) y[j] += x[i] * row[j];
+  }
+}
+
+// Обобщённое микроядро: компилятор сам раскладывает acc по регистрам
+template <class T, int MR, int NR>
+void GemmGeneric(int kc, const T *__restrict a, const T *__restrict b, T *c,
+                 int ldc, int mr, int nr, bool accumulate) {
+  T acc[MR][NR] = {};
+
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < MR; i++)
+      for (int j = 0; j < NR; j++) acc[i][j] += a[i] * b[j];
+    a += MR;
+    b += NR;
+  }
+
+  for (int i = 0; i < mr; i++) {
+    T *row = c + i * ldc;
+    if (accumulate) {
+      for (int j = 0; j < nr; j++) row[j] += acc[i][j];
+    } else {
+      for (int j = 0; j < nr; j++) row[j] = acc[i][j];
+    }
+  }
+}
+
+// Записывает временный блок tile (шаг NR) в угол C размером mr x nr
+template <int NR, class T>
+void StoreEdge(const T *tile, T *c, int ldc, int mr, int nr,
+               bool accumulate) {
+  for (int i = 0; i < mr; i++) {
+    T *row = c + i * ldc;
+    if (accumulate) {
+      for (int j = 0; j < nr; j++) row[j] += tile[i * NR + j];
+    } else {
+      for (int j = 0; j < nr; j++) row[j] = tile[i * NR + j];
+    }
+  }
+}
+
+#ifdef S21_X86
+
+// SSE2
+
+__attribute__((target("sse2"))) void AddSse2(double *dst, const double *src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128d d0 = _mm_loadu_pd(dst + i), d1 = _mm_loadu_pd(dst + i + 2);
+    d0 = _mm_add_pd(d0, _mm_loadu_pd(src + i));
+    d1 = _mm_add_pd(d1, _mm_loadu_pd(src + i + 2));
+    _mm_storeu_pd(dst + i, d0);
+    _mm_storeu_pd(dst + i + 2, d1);
+  }
+  for (; i < n; i++) dst[i] += src[i];
+}
+
+__attribute__((target("sse2"))) void SubSse2(double *dst, const double *src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128d d0 = _mm_loadu_pd(dst + i), d1 = _mm_loadu_pd(dst + i + 2);
+    d0 = _mm_sub_pd(d0, _mm_loadu_pd(src + i));
+    d1 = _mm_sub_pd(d1, _mm_loadu_pd(src + i + 2));
+    _mm_storeu_pd(dst + i, d0);
+    _mm_storeu_pd(dst + i + 2, d1);
+  }
+  for (; i < n; i++) dst[i] -= src[i];
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double *dst, double num,
+                                               std::size_t n) {
+  __m128d k = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), k));
+    _mm_storeu_pd(dst + i + 2, _mm_mul_pd(_mm_loadu_pd(dst + i + 2), k));
+  }
+  for (; i < n; i++) dst[i] *= num;
+}
+
+__attribute__((target("sse2"))) void ZeroSse2(double *dst, std::size_t n) {
+  __m128d z = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) _mm_storeu_pd(dst + i, z);
+  for (; i < n; i++) dst[i] = 0.0;
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double *a,
+                                               const double *b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    // NEQ_UQ: NaN не равен ничему, как и при скалярном сравнении
+    __m128d neq = _mm_cmpneq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+    if (_mm_movemask_pd(neq)) return false;
+  }
+  for (; i < n; i++)
+    if (a[i] != b[i]) return false;
+  return true;
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(const double *src,
+                                                   int lds, double *dst,
+                                                   int ldd, int rows,
+                                                   int cols) {
+  int i = 0, j = 0;
+  for (i = 0; i + 2 <= rows; i += 2) {
+    const double *s = src + (std::ptrdiff_t)i * lds;
+    for (j = 0; j + 2 <= cols; j += 2) {
+      __m128d r0 = _mm_loadu_pd(s + j), r1 = _mm_loadu_pd(s + lds + j);
+      double *d = dst + (std::ptrdiff_t)j * ldd + i;
+      _mm_storeu_pd(d, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(d + ldd, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  TransposeEdge(src, lds, dst, ldd, rows, cols, i, cols - cols % 2);
+}
+
+// AVX2 + FMA
+
+__attribute__((target("avx2,fma"))) void AddAvx2(double *dst,
+                                                 const double *src,
+                                                 std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d d0 = _mm256_loadu_pd(dst + i), d1 = _mm256_loadu_pd(dst + i + 4);
+    d0 = _mm256_add_pd(d0, _mm256_loadu_pd(src + i));
+    d1 = _mm256_add_pd(d1, _mm256_loadu_pd(src + i + 4));
+    _mm256_storeu_pd(dst + i, d0);
+    _mm256_storeu_pd(dst + i + 4, d1);
+  }
+  for (; i < n; i++) dst[i] += src[i];
+}
+
+__attribute__((target("avx2,fma"))) void SubAvx2(double *dst,
+                                                 const double *src,
+                                                 std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d d0 = _mm256_loadu_pd(dst + i), d1 = _mm256_loadu_pd(dst + i + 4);
+    d0 = _mm256_sub_pd(d0, _mm256_loadu_pd(src + i));
+    d1 = _mm256_sub_pd(d1, _mm256_loadu_pd(src + i + 4));
+    _mm256_storeu_pd(dst + i, d0);
+    _mm256_storeu_pd(dst + i + 4, d1);
+  }
+  for (; i < n; i++) dst[i] -= src[i];
+}
+
+__attribute__((target("avx2,fma"))) void ScaleAvx2(double *dst, double num,
+                                                   std::size_t n) {
+  __m256d k = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), k));
+    _mm256_storeu_pd(dst + i + 4,
+                     _mm256_mul_pd(_mm256_loadu_pd(dst + i + 4), k));
+  }
+  for (; i < n; i++) dst[i] *= num;
+}
+
+__attribute__((target("avx2,fma"))) void ZeroAvx2(double *dst,
+                                                  std::size_t n) {
+  __m256d z = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm256_storeu_pd(dst + i, z);
+  for (; i < n; i++) dst[i] = 0.0;
+}
+
+__attribute__((target("avx2,fma"))) bool EqualAvx2(const double *a,
+                                                   const double *b,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d neq = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i),
+                                _CMP_NEQ_UQ);
+    if (_mm256_movemask_pd(neq)) return false;
+  }
+  for (; i < n; i++)
+    if (a[i] != b[i]) return false;
+  return true;
+}
+
+// Транспонирование блоками 4 x 4: unpack внутри 128-битных половин, затем
+// перестановка половин
+__attribute__((target("avx2,fma"))) void TransposeAvx2(const double *src,
+                                                       int lds, double *dst,
+                                                       int ldd, int rows,
+                                                       int cols) {
+  int i = 0, j = 0;
+  for (i = 0; i + 4 <= rows; i += 4) {
+    const double *s = src + (std::ptrdiff_t)i * lds;
+    for (j = 0; j + 4 <= cols; j += 4) {
+      __m256d r0 = _mm256_loadu_pd(s + j);
+      __m256d r1 = _mm256_loadu_pd(s + lds + j);
+      __m256d r2 = _mm256_loadu_pd(s + 2 * lds + j);
+      __m256d r3 = _mm256_loadu_pd(s + 3 * lds + j);
+      __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+      __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+      double *d = dst + (std::ptrdiff_t)j * ldd + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(d + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(d + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(d + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+  TransposeEdge(src, lds, dst, ldd, rows, cols, i, cols - cols % 4);
+}
+
+// GEMV по R строк за проход: загрузка x общая для всех строк, у каждой
+// строки свой аккумулятор. Хвост строк короче вектора досчитывается скалярно.
+template <int R>
+__attribute__((target("avx2,fma"))) void GemvRowsAvx2(const double *a,
+                                                      int lda,
+                                                      const double *x,
+                                                      double *y, int cols) {
+  __m256d acc[R];
+  for (int k = 0; k < R; k++) acc[k] = _mm256_setzero_pd();
+  int j = 0;
+  for (; j + 4 <= cols; j += 4) {
+    __m256d xv = _mm256_loadu_pd(x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm256_fmadd_pd(_mm256_loadu_pd(a + k * lda + j), xv, acc[k]);
+  }
+  for (int k = 0; k < R; k++) {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(acc[k]),
+                           _mm256_extractf128_pd(acc[k], 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    for (int t = j; t < cols; t++) sum += a[k * lda + t] * x[t];
+    y[k] = sum;
+  }
+}
+
+__attribute__((target("avx2,fma"))) void GemvAvx2(const double *a, int lda,
+                                                  const double *x, double *y,
+                                                  int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvRowsAvx2<4>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+  for (; i < rows; i++)
+    GemvRowsAvx2<1>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+}
+
+// Вектор на матрицу по R строк за проход: y читается и пишется один раз на
+// R строк
+template <int R>
+__attribute__((target("avx2,fma"))) void GemvTRowsAvx2(const double *a,
+                                                       int lda,
+                                                       const double *x,
+                                                       double *y, int cols) {
+  __m256d xv[R];
+  for (int k = 0; k < R; k++) xv[k] = _mm256_set1_pd(x[k]);
+  int j = 0;
+  for (; j + 4 <= cols; j += 4) {
+    __m256d yv = _mm256_loadu_pd(y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm256_fmadd_pd(_mm256_loadu_pd(a + k * lda + j), xv[k], yv);
+    _mm256_storeu_pd(y + j, yv);
+  }
+  for (; j < cols; j++)
+    for (int k = 0; k < R; k++) y[j] += x[k] * a[k * lda + j];
+}
+
+__attribute__((target("avx2,fma"))) void GemvTAvx2(const double *a, int lda,
+                                                   const double *x, double *y,
+                                                   int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvTRowsAvx2<4>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+  for (; i < rows; i++)
+    GemvTRowsAvx2<1>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+}
+
+// Микроядро 6 x 8: 12 аккумуляторов ymm, на каждом шаге 2 загрузки B и
+// 6 широковещательных загрузок A
+__attribute__((target("avx2,fma"))) void GemmAvx2(
+    int kc, const double *__restrict a, const double *__restrict b, double *c,
+    int ldc, int mr, int nr, bool accumulate) {
+  constexpr int MR = 6, NR = 8;
+  __m256d acc[MR][2];
+  for (int i = 0; i < MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+
+  for (int p = 0; p < kc; p++) {
+    __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+#pragma GCC unroll 6
+    for (int i = 0; i < MR; i++) {
+      __m256d ai = _mm256_broadcast_sd(a + i);
+      acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += MR;
+    b += NR;
+  }
+
+  if (mr == MR && nr == NR) {
+    for (int i = 0; i < MR; i++) {
+      double *row = c + i * ldc;
+      if (accumulate) {
+        acc[i][0] = _mm256_add_pd(acc[i][0], _mm256_loadu_pd(row));
+        acc[i][1] = _mm256_add_pd(acc[i][1], _mm256_loadu_pd(row + 4));
+      }
+      _mm256_storeu_pd(row, acc[i][0]);
+      _mm256_storeu_pd(row + 4, acc[i][1]);
+    }
+  } else {
+    alignas(32) double tile[MR * NR];
+    for (int i = 0; i < MR; i++) {
+      _mm256_store_pd(tile + i * NR, acc[i][0]);
+      _mm256_store_pd(tile + i * NR + 4, acc[i][1]);
+    }
+    StoreEdge<NR>(tile, c, ldc, mr, nr, accumulate);
+  }
+}
+
+// AVX-512
+
+__attribute__((target("avx512f"))) void AddAvx512(double *dst,
+                                                  const double *src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  if (i < n) {
+    __mmask8 m = (__mmask8)((1u << (n - i)) - 1);
+    __m512d d = _mm512_maskz_loadu_pd(m, dst + i);
+    d = _mm512_add_pd(d, _mm512_maskz_loadu_pd(m, src + i));
+    _mm512_mask_storeu_pd(dst + i, m, d);
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double *dst,
+                                                  const double *src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  if (i < n) {
+    __mmask8 m = (__mmask8)((1u << (n - i)) - 1);
+    __m512d d = _mm512_maskz_loadu_pd(m, dst + i);
+    d = _mm512_sub_pd(d, _mm512_maskz_loadu_pd(m, src + i));
+    _mm512_mask_storeu_pd(dst + i, m, d);
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double *dst, double num,
+                                                    std::size_t n) {
+  __m512d k = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), k));
+  if (i < n) {
+    __mmask8 m = (__mmask8)((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(dst + i, m,
+                          _mm512_mul_pd(_mm512_maskz_loadu_pd(m, dst + i), k));
+  }
+}
+
+__attribute__((target("avx512f"))) void ZeroAvx512(double *dst,
+                                                   std::size_t n) {
+  __m512d z = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm512_storeu_pd(dst + i, z);
+  if (i < n) _mm512_mask_storeu_pd(dst + i, (__mmask8)((1u << (n - i)) - 1), z);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double *a,
+                                                    const double *b,
+                                                    std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    if (_mm512_cmp_pd_mask(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i),
+                           _CMP_NEQ_UQ))
+      return false;
+  }
+  if (i < n) {
+    __mmask8 m = (__mmask8)((1u << (n - i)) - 1);
+    if (_mm512_mask_cmp_pd_mask(m, _mm512_maskz_loadu_pd(m, a + i),
+                                _mm512_maskz_loadu_pd(m, b + i), _CMP_NEQ_UQ))
+      return false;
+  }
+  return true;
+}
+
+// Транспонирование блоками 8 x 8 в три шага перестановок двух регистров:
+// чередование элементов пар строк, затем дважды чётные и нечётные
+// 128-битные четверти. _mm512_unpack*_pd и _mm512_shuffle_f64x2 здесь не
+// используются: в GCC 12 они дают ложное -Wmaybe-uninitialized.
+__attribute__((target("avx512f"))) void TransposeAvx512(const double *src,
+                                                        int lds, double *dst,
+                                                        int ldd, int rows,
+                                                        int cols) {
+  const __m512i lo = _mm512_set_epi64(14, 6, 12, 4, 10, 2, 8, 0);
+  const __m512i hi = _mm512_set_epi64(15, 7, 13, 5, 11, 3, 9, 1);
+  const __m512i even = _mm512_set_epi64(13, 12, 9, 8, 5, 4, 1, 0);
+  const __m512i odd = _mm512_set_epi64(15, 14, 11, 10, 7, 6, 3, 2);
+  int i = 0, j = 0;
+  for (i = 0; i + 8 <= rows; i += 8) {
+    const double *s = src + (std::ptrdiff_t)i * lds;
+    for (j = 0; j + 8 <= cols; j += 8) {
+      __m512d t[8], u[8];
+      for (int k = 0; k < 8; k += 2) {
+        __m512d r0 = _mm512_loadu_pd(s + k * lds + j);
+        __m512d r1 = _mm512_loadu_pd(s + (k + 1) * lds + j);
+        t[k] = _mm512_permutex2var_pd(r0, lo, r1);      // Столбцы 0, 2, 4, 6
+        t[k + 1] = _mm512_permutex2var_pd(r0, hi, r1);  // Столбцы 1, 3, 5, 7
+      }
+      for (int k = 0; k < 8; k += 4) {
+        u[k] = _mm512_permutex2var_pd(t[k], even, t[k + 2]);          // 0, 4
+        u[k + 1] = _mm512_permutex2var_pd(t[k + 1], even, t[k + 3]);  // 1, 5
+        u[k + 2] = _mm512_permutex2var_pd(t[k], odd, t[k + 2]);       // 2, 6
+        u[k + 3] = _mm512_permutex2var_pd(t[k + 1], odd, t[k + 3]);   // 3, 7
+      }
+      double *d = dst + (std::ptrdiff_t)j * ldd + i;
+      for (int k = 0; k < 4; k++) {
+        _mm512_storeu_pd(d + k * ldd,
+                         _mm512_permutex2var_pd(u[k], even, u[k + 4]));
+        _mm512_storeu_pd(d + (k + 4) * ldd,
+                         _mm512_permutex2var_pd(u[k], odd, u[k + 4]));
+      }
+    }
+  }
+  TransposeEdge(src, lds, dst, ldd, rows, cols, i, cols - cols % 8);
+}
+
+// Сумма элементов регистра. _mm512_reduce_add_* в GCC 12 дают то же ложное
+// -Wmaybe-uninitialized, поэтому элементы складываются через стек.
+__attribute__((target("avx512f"))) double SumAvx512(__m512d v) {
+  alignas(64) double lanes[8];
+  _mm512_store_pd(lanes, v);
+  double sum = 0;
+  for (double lane : lanes) sum += lane;
+  return sum;
+}
+
+// GEMV по R строк за проход; хвост строки загружается по маске
+template <int R>
+__attribute__((target("avx512f"))) void GemvRowsAvx512(const double *a,
+                                                       int lda,
+                                                       const double *x,
+                                                       double *y, int cols) {
+  __m512d acc[R];
+  for (int k = 0; k < R; k++) acc[k] = _mm512_setzero_pd();
+  int j = 0;
+  for (; j + 8 <= cols; j += 8) {
+    __m512d xv = _mm512_loadu_pd(x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm512_fmadd_pd(_mm512_loadu_pd(a + k * lda + j), xv, acc[k]);
+  }
+  if (j < cols) {
+    __mmask8 m = (__mmask8)((1u << (cols - j)) - 1);
+    __m512d xv = _mm512_maskz_loadu_pd(m, x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a + k * lda + j), xv,
+                               acc[k]);
+  }
+  for (int k = 0; k < R; k++) y[k] = SumAvx512(acc[k]);
+}
+
+__attribute__((target("avx512f"))) void GemvAvx512(const double *a, int lda,
+                                                   const double *x, double *y,
+                                                   int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvRowsAvx512<4>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+  for (; i < rows; i++)
+    GemvRowsAvx512<1>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+}
+
+template <int R>
+__attribute__((target("avx512f"))) void GemvTRowsAvx512(const double *a,
+                                                        int lda,
+                                                        const double *x,
+                                                        double *y, int cols) {
+  __m512d xv[R];
+  for (int k = 0; k < R; k++) xv[k] = _mm512_set1_pd(x[k]);
+  int j = 0;
+  for (; j + 8 <= cols; j += 8) {
+    __m512d yv = _mm512_loadu_pd(y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm512_fmadd_pd(_mm512_loadu_pd(a + k * lda + j), xv[k], yv);
+    _mm512_storeu_pd(y + j, yv);
+  }
+  if (j < cols) {
+    __mmask8 m = (__mmask8)((1u << (cols - j)) - 1);
+    __m512d yv = _mm512_maskz_loadu_pd(m, y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a + k * lda + j), xv[k],
+                           yv);
+    _mm512_mask_storeu_pd(y + j, m, yv);
+  }
+}
+
+__attribute__((target("avx512f"))) void GemvTAvx512(const double *a, int lda,
+                                                    const double *x,
+                                                    double *y, int rows,
+                                                    int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvTRowsAvx512<4>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+  for (; i < rows; i++)
+    GemvTRowsAvx512<1>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+}
+
+// Микроядро 8 x 16: 16 аккумуляторов zmm
+__attribute__((target("avx512f"))) void GemmAvx512(
+    int kc, const double *__restrict a, const double *__restrict b, double *c,
+    int ldc, int mr, int nr, bool accumulate) {
+  constexpr int MR = 8, NR = 16;
+  __m512d acc[MR][2];
+  for (int i = 0; i < MR; i++) acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+
+  for (int p = 0; p < kc; p++) {
+    __m512d b0 = _mm512_loadu_pd(b), b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+    for (int i = 0; i < MR; i++) {
+      __m512d ai = _mm512_set1_pd(a[i]);
+      acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += MR;
+    b += NR;
+  }
+
+  if (mr == MR && nr == NR) {
+    for (int i = 0; i < MR; i++) {
+      double *row = c + i * ldc;
+      if (accumulate) {
+        acc[i][0] = _mm512_add_pd(acc[i][0], _mm512_loadu_pd(row));
+        acc[i][1] = _mm512_add_pd(acc[i][1], _mm512_loadu_pd(row + 8));
+      }
+      _mm512_storeu_pd(row, acc[i][0]);
+      _mm512_storeu_pd(row + 8, acc[i][1]);
+    }
+  } else {
+    alignas(64) double tile[MR * NR];
+    for (int i = 0; i < MR; i++) {
+      _mm512_store_pd(tile + i * NR, acc[i][0]);
+      _mm512_store_pd(tile + i * NR + 8, acc[i][1]);
+    }
+    StoreEdge<NR>(tile, c, ldc, mr, nr, accumulate);
+  }
+}
+
+// FLOAT: те же ядра с вдвое большим числом элементов в регистре
+
+__attribute__((target("sse2"))) void AddSse2(float *dst, const float *src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128 d0 = _mm_loadu_ps(dst + i), d1 = _mm_loadu_ps(dst + i + 4);
+    d0 = _mm_add_ps(d0, _mm_loadu_ps(src + i));
+    d1 = _mm_add_ps(d1, _mm_loadu_ps(src + i + 4));
+    _mm_storeu_ps(dst + i, d0);
+    _mm_storeu_ps(dst + i + 4, d1);
+  }
+  for (; i < n; i++) dst[i] += src[i];
+}
+
+__attribute__((target("sse2"))) void SubSse2(float *dst, const float *src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128 d0 = _mm_loadu_ps(dst + i), d1 = _mm_loadu_ps(dst + i + 4);
+    d0 = _mm_sub_ps(d0, _mm_loadu_ps(src + i));
+    d1 = _mm_sub_ps(d1, _mm_loadu_ps(src + i + 4));
+    _mm_storeu_ps(dst + i, d0);
+    _mm_storeu_ps(dst + i + 4, d1);
+  }
+  for (; i < n; i++) dst[i] -= src[i];
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(float *dst, float num,
+                                               std::size_t n) {
+  __m128 k = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), k));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_loadu_ps(dst + i + 4), k));
+  }
+  for (; i < n; i++) dst[i] *= num;
+}
+
+__attribute__((target("sse2"))) void ZeroSse2(float *dst, std::size_t n) {
+  __m128 z = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm_storeu_ps(dst + i, z);
+  for (; i < n; i++) dst[i] = 0.0f;
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const float *a, const float *b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 neq = _mm_cmpneq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    if (_mm_movemask_ps(neq)) return false;
+  }
+  for (; i < n; i++)
+    if (a[i] != b[i]) return false;
+  return true;
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(const float *src, int lds,
+                                                   float *dst, int ldd,
+                                                   int rows, int cols) {
+  int i = 0, j = 0;
+  for (i = 0; i + 4 <= rows; i += 4) {
+    const float *s = src + (std::ptrdiff_t)i * lds;
+    for (j = 0; j + 4 <= cols; j += 4) {
+      __m128 r0 = _mm_loadu_ps(s + j), r1 = _mm_loadu_ps(s + lds + j);
+      __m128 r2 = _mm_loadu_ps(s + 2 * lds + j);
+      __m128 r3 = _mm_loadu_ps(s + 3 * lds + j);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      float *d = dst + (std::ptrdiff_t)j * ldd + i;
+      _mm_storeu_ps(d, r0);
+      _mm_storeu_ps(d + ldd, r1);
+      _mm_storeu_ps(d + 2 * ldd, r2);
+      _mm_storeu_ps(d + 3 * ldd, r3);
+    }
+  }
+  TransposeEdge(src, lds, dst, ldd, rows, cols, i, cols - cols % 4);
+}
+
+__attribute__((target("avx2,fma"))) void AddAvx2(float *dst, const float *src,
+                                                 std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 d0 = _mm256_loadu_ps(dst + i), d1 = _mm256_loadu_ps(dst + i + 8);
+    d0 = _mm256_add_ps(d0, _mm256_loadu_ps(src + i));
+    d1 = _mm256_add_ps(d1, _mm256_loadu_ps(src + i + 8));
+    _mm256_storeu_ps(dst + i, d0);
+    _mm256_storeu_ps(dst + i + 8, d1);
+  }
+  for (; i < n; i++) dst[i] += src[i];
+}
+
+__attribute__((target("avx2,fma"))) void SubAvx2(float *dst, const float *src,
+                                                 std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 d0 = _mm256_loadu_ps(dst + i), d1 = _mm256_loadu_ps(dst + i + 8);
+    d0 = _mm256_sub_ps(d0, _mm256_loadu_ps(src + i));
+    d1 = _mm256_sub_ps(d1, _mm256_loadu_ps(src + i + 8));
+    _mm256_storeu_ps(dst + i, d0);
+    _mm256_storeu_ps(dst + i + 8, d1);
+  }
+  for (; i < n; i++) dst[i] -= src[i];
+}
+
+__attribute__((target("avx2,fma"))) void ScaleAvx2(float *dst, float num,
+                                                   std::size_t n) {
+  __m256 k = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), k));
+    _mm256_storeu_ps(dst + i + 8,
+                     _mm256_mul_ps(_mm256_loadu_ps(dst + i + 8), k));
+  }
+  for (; i < n; i++) dst[i] *= num;
+}
+
+__attribute__((target("avx2,fma"))) void ZeroAvx2(float *dst, std::size_t n) {
+  __m256 z = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm256_storeu_ps(dst + i, z);
+  for (; i < n; i++) dst[i] = 0.0f;
+}
+
+__attribute__((target("avx2,fma"))) bool EqualAvx2(const float *a,
+                                                   const float *b,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 neq = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                               _CMP_NEQ_UQ);
+    if (_mm256_movemask_ps(neq)) return false;
+  }
+  for (; i < n; i++)
+    if (a[i] != b[i]) return false;
+  return true;
+}
+
+// Транспонирование блоками 8 x 8: unpack пар строк, shuffle четвёрок внутри
+// 128-битных половин, затем перестановка половин
+__attribute__((target("avx2,fma"))) void TransposeAvx2(const float *src,
+                                                       int lds, float *dst,
+                                                       int ldd, int rows,
+                                                       int cols) {
+  int i = 0, j = 0;
+  for (i = 0; i + 8 <= rows; i += 8) {
+    const float *s = src + (std::ptrdiff_t)i * lds;
+    for (j = 0; j + 8 <= cols; j += 8) {
+      __m256 t[8], u[8];
+      for (int k = 0; k < 8; k += 2) {
+        __m256 r0 = _mm256_loadu_ps(s + k * lds + j);
+        __m256 r1 = _mm256_loadu_ps(s + (k + 1) * lds + j);
+        t[k] = _mm256_unpacklo_ps(r0, r1);
+        t[k + 1] = _mm256_unpackhi_ps(r0, r1);
+      }
+      for (int k = 0; k < 8; k += 4) {
+        u[k] = _mm256_shuffle_ps(t[k], t[k + 2], 0x44);
+        u[k + 1] = _mm256_shuffle_ps(t[k], t[k + 2], 0xee);
+        u[k + 2] = _mm256_shuffle_ps(t[k + 1], t[k + 3], 0x44);
+        u[k + 3] = _mm256_shuffle_ps(t[k + 1], t[k + 3], 0xee);
+      }
+      float *d = dst + (std::ptrdiff_t)j * ldd + i;
+      for (int k = 0; k < 4; k++) {
+        _mm256_storeu_ps(d + k * ldd,
+                         _mm256_permute2f128_ps(u[k], u[k + 4], 0x20));
+        _mm256_storeu_ps(d + (k + 4) * ldd,
+                         _mm256_permute2f128_ps(u[k], u[k + 4], 0x31));
+      }
+    }
+  }
+  TransposeEdge(src, lds, dst, ldd, rows, cols, i, cols - cols % 8);
+}
+
+// GEMV для float: те же проходы по R строк, 8 элементов в регистре
+template <int R>
+__attribute__((target("avx2,fma"))) void GemvRowsAvx2(const float *a,
+                                                      int lda,
+                                                      const float *x,
+                                                      float *y, int cols) {
+  __m256 acc[R];
+  for (int k = 0; k < R; k++) acc[k] = _mm256_setzero_ps();
+  int j = 0;
+  for (; j + 8 <= cols; j += 8) {
+    __m256 xv = _mm256_loadu_ps(x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm256_fmadd_ps(_mm256_loadu_ps(a + k * lda + j), xv, acc[k]);
+  }
+  for (int k = 0; k < R; k++) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc[k]),
+                          _mm256_extractf128_ps(acc[k], 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    float sum = _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    for (int t = j; t < cols; t++) sum += a[k * lda + t] * x[t];
+    y[k] = sum;
+  }
+}
+
+__attribute__((target("avx2,fma"))) void GemvAvx2(const float *a, int lda,
+                                                  const float *x, float *y,
+                                                  int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvRowsAvx2<4>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+  for (; i < rows; i++)
+    GemvRowsAvx2<1>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+}
+
+template <int R>
+__attribute__((target("avx2,fma"))) void GemvTRowsAvx2(const float *a,
+                                                       int lda,
+                                                       const float *x,
+                                                       float *y, int cols) {
+  __m256 xv[R];
+  for (int k = 0; k < R; k++) xv[k] = _mm256_set1_ps(x[k]);
+  int j = 0;
+  for (; j + 8 <= cols; j += 8) {
+    __m256 yv = _mm256_loadu_ps(y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm256_fmadd_ps(_mm256_loadu_ps(a + k * lda + j), xv[k], yv);
+    _mm256_storeu_ps(y + j, yv);
+  }
+  for (; j < cols; j++)
+    for (int k = 0; k < R; k++) y[j] += x[k] * a[k * lda + j];
+}
+
+__attribute__((target("avx2,fma"))) void GemvTAvx2(const float *a, int lda,
+                                                   const float *x, float *y,
+                                                   int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvTRowsAvx2<4>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+  for (; i < rows; i++)
+    GemvTRowsAvx2<1>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+}
+
+// Микроядро 6 x 16: 12 аккумуляторов ymm по 8 элементов
+__attribute__((target("avx2,fma"))) void GemmAvx2(
+    int kc, const float *__restrict a, const float *__restrict b, float *c,
+    int ldc, int mr, int nr, bool accumulate) {
+  constexpr int MR = 6, NR = 16;
+  __m256 acc[MR][2];
+  for (int i = 0; i < MR; i++) acc[i][0] = acc[i][1] = _mm256_setzero_ps();
+
+  for (int p = 0; p < kc; p++) {
+    __m256 b0 = _mm256_loadu_ps(b), b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 6
+    for (int i = 0; i < MR; i++) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += MR;
+    b += NR;
+  }
+
+  if (mr == MR && nr == NR) {
+    for (int i = 0; i < MR; i++) {
+      float *row = c + i * ldc;
+      if (accumulate) {
+        acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_loadu_ps(row));
+        acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_loadu_ps(row + 8));
+      }
+      _mm256_storeu_ps(row, acc[i][0]);
+      _mm256_storeu_ps(row + 8, acc[i][1]);
+    }
+  } else {
+    alignas(32) float tile[MR * NR];
+    for (int i = 0; i < MR; i++) {
+      _mm256_store_ps(tile + i * NR, acc[i][0]);
+      _mm256_store_ps(tile + i * NR + 8, acc[i][1]);
+    }
+    StoreEdge<NR>(tile, c, ldc, mr, nr, accumulate);
+  }
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float *dst,
+                                                  const float *src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    __m512 d = _mm512_maskz_loadu_ps(m, dst + i);
+    d = _mm512_add_ps(d, _mm512_maskz_loadu_ps(m, src + i));
+    _mm512_mask_storeu_ps(dst + i, m, d);
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float *dst,
+                                                  const float *src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(dst + i, _mm512_sub_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    __m512 d = _mm512_maskz_loadu_ps(m, dst + i);
+    d = _mm512_sub_ps(d, _mm512_maskz_loadu_ps(m, src + i));
+    _mm512_mask_storeu_ps(dst + i, m, d);
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float *dst, float num,
+                                                    std::size_t n) {
+  __m512 k = _mm512_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), k));
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    _mm512_mask_storeu_ps(dst + i, m,
+                          _mm512_mul_ps(_mm512_maskz_loadu_ps(m, dst + i), k));
+  }
+}
+
+__attribute__((target("avx512f"))) void ZeroAvx512(float *dst,
+                                                   std::size_t n) {
+  __m512 z = _mm512_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) _mm512_storeu_ps(dst + i, z);
+  if (i < n)
+    _mm512_mask_storeu_ps(dst + i, (__mmask16)((1u << (n - i)) - 1), z);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float *a,
+                                                    const float *b,
+                                                    std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    if (_mm512_cmp_ps_mask(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+                           _CMP_NEQ_UQ))
+      return false;
+  }
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    if (_mm512_mask_cmp_ps_mask(m, _mm512_maskz_loadu_ps(m, a + i),
+                                _mm512_maskz_loadu_ps(m, b + i), _CMP_NEQ_UQ))
+      return false;
+  }
+  return true;
+}
+
+__attribute__((target("avx512f"))) float SumAvx512(__m512 v) {
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, v);
+  float sum = 0;
+  for (float lane : lanes) sum += lane;
+  return sum;
+}
+
+// GEMV для float: 16 элементов в регистре, хвост по маске
+template <int R>
+__attribute__((target("avx512f"))) void GemvRowsAvx512(const float *a,
+                                                       int lda,
+                                                       const float *x,
+                                                       float *y, int cols) {
+  __m512 acc[R];
+  for (int k = 0; k < R; k++) acc[k] = _mm512_setzero_ps();
+  int j = 0;
+  for (; j + 16 <= cols; j += 16) {
+    __m512 xv = _mm512_loadu_ps(x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm512_fmadd_ps(_mm512_loadu_ps(a + k * lda + j), xv, acc[k]);
+  }
+  if (j < cols) {
+    __mmask16 m = (__mmask16)((1u << (cols - j)) - 1);
+    __m512 xv = _mm512_maskz_loadu_ps(m, x + j);
+    for (int k = 0; k < R; k++)
+      acc[k] = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + k * lda + j), xv,
+                               acc[k]);
+  }
+  for (int k = 0; k < R; k++) y[k] = SumAvx512(acc[k]);
+}
+
+__attribute__((target("avx512f"))) void GemvAvx512(const float *a, int lda,
+                                                   const float *x, float *y,
+                                                   int rows, int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvRowsAvx512<4>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+  for (; i < rows; i++)
+    GemvRowsAvx512<1>(a + (std::ptrdiff_t)i * lda, lda, x, y + i, cols);
+}
+
+template <int R>
+__attribute__((target("avx512f"))) void GemvTRowsAvx512(const float *a,
+                                                        int lda,
+                                                        const float *x,
+                                                        float *y, int cols) {
+  __m512 xv[R];
+  for (int k = 0; k < R; k++) xv[k] = _mm512_set1_ps(x[k]);
+  int j = 0;
+  for (; j + 16 <= cols; j += 16) {
+    __m512 yv = _mm512_loadu_ps(y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm512_fmadd_ps(_mm512_loadu_ps(a + k * lda + j), xv[k], yv);
+    _mm512_storeu_ps(y + j, yv);
+  }
+  if (j < cols) {
+    __mmask16 m = (__mmask16)((1u << (cols - j)) - 1);
+    __m512 yv = _mm512_maskz_loadu_ps(m, y + j);
+    for (int k = 0; k < R; k++)
+      yv = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + k * lda + j), xv[k],
+                           yv);
+    _mm512_mask_storeu_ps(y + j, m, yv);
+  }
+}
+
+__attribute__((target("avx512f"))) void GemvTAvx512(const float *a, int lda,
+                                                    const float *x,
+                                                    float *y, int rows,
+                                                    int cols) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4)
+    GemvTRowsAvx512<4>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+  for (; i < rows; i++)
+    GemvTRowsAvx512<1>(a + (std::ptrdiff_t)i * lda, lda, x + i, y, cols);
+}
+
+// Микроядро 8 x 32: 16 аккумуляторов zmm по 16 элементов
+__attribute__((target("avx512f"))) void GemmAvx512(
+    int kc, const float *__restrict a, const float *__restrict b, float *c,
+    int ldc, int mr, int nr, bool accumulate) {
+  constexpr int MR = 8, NR = 32;
+  __m512 acc[MR][2];
+  for (int i = 0; i < MR; i++) acc[i][0] = acc[i][1] = _mm512_setzero_ps();
+
+  for (int p = 0; p < kc; p++) {
+    __m512 b0 = _mm512_loadu_ps(b), b1 = _mm512_loadu_ps(b + 16);
+#pragma GCC unroll 8
+    for (int i = 0; i < MR; i++) {
+      __m512 ai = _mm512_set1_ps(a[i]);
+      acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += MR;
+    b += NR;
+  }
+
+  if (mr == MR && nr == NR) {
+    for (int i = 0; i < MR; i++) {
+      float *row = c + i * ldc;
+      if (accumulate) {
+        acc[i][0] = _mm512_add_ps(acc[i][0], _mm512_loadu_ps(row));
+        acc[i][1] = _mm512_add_ps(acc[i][1], _mm512_loadu_ps(row + 16));
+      }
+      _mm512_storeu_ps(row, acc[i][0]);
+      _mm512_storeu_ps(row + 16, acc[i][1]);
+    }
+  } else {
+    alignas(64) float tile[MR * NR];
+    for (int i = 0; i < MR; i++) {
+      _mm512_store_ps(tile + i * NR, acc[i][0]);
+      _mm512_store_ps(tile + i * NR + 16, acc[i][1]);
+    }
+    StoreEdge<NR>(tile, c, ldc, mr, nr, accumulate);
+  }
+}
+
+#endif  // S21_X86
+
+// ТАБЛИЦЫ
+
+template <class T>
+const S21KernelsT<T> kScalarKernels = {
+    S21Isa::kScalar,   "scalar",        AddScalar<T>,   SubScalar<T>,
+    ScaleScalar<T>,    ZeroScalar<T>,   EqualScalar<T>, TransposeScalar<T>,
+    GemvScalar<T>,     GemvTScalar<T>,  4,              4,
+    GemmGeneric<T, 4, 4>};
+
+#ifdef S21_X86
+const S21KernelsT<double> kSse2Kernels = {
+    S21Isa::kSse2,      "sse2",
+    AddSse2,            SubSse2,
+    ScaleSse2,          ZeroSse2,
+    EqualSse2,          TransposeSse2,
+    GemvScalar<double>, GemvTScalar<double>,
+    4,                  4,
+    GemmGeneric<double, 4, 4>};
+
+const S21KernelsT<double> kAvx2Kernels = {
+    S21Isa::kAvx2, "avx2+fma",    AddAvx2,  SubAvx2,   ScaleAvx2, ZeroAvx2,
+    EqualAvx2,     TransposeAvx2, GemvAvx2, GemvTAvx2, 6,         8,
+    GemmAvx2};
+
+const S21KernelsT<double> kAvx512Kernels = {
+    S21Isa::kAvx512, "avx512",        AddAvx512,  SubAvx512,
+    ScaleAvx512,     ZeroAvx512,      EqualAvx512, TransposeAvx512,
+    GemvAvx512,      GemvTAvx512,     8,           16,
+    GemmAvx512};
+
+const S21KernelsT<float> kSse2FloatKernels = {
+    S21Isa::kSse2,     "sse2",
+    AddSse2,           SubSse2,
+    ScaleSse2,         ZeroSse2,
+    EqualSse2,         TransposeSse2,
+    GemvScalar<float>, GemvTScalar<float>,
+    4,                 8,
+    GemmGeneric<float, 4, 8>};
+
+const S21KernelsT<float> kAvx2FloatKernels = {
+    S21Isa::kAvx2, "avx2+fma",    AddAvx2,  SubAvx2,   ScaleAvx2, ZeroAvx2,
+    EqualAvx2,     TransposeAvx2, GemvAvx2, GemvTAvx2, 6,         16,
+    GemmAvx2};
+
+// Транспонирование float блоками 8 x 8 из AVX2: процессоры с AVX-512
+// поддерживают и его
+const S21KernelsT<float> kAvx512FloatKernels = {
+    S21Isa::kAvx512, "avx512",    AddAvx512,     SubAvx512,
+    ScaleAvx512,     ZeroAvx512,  EqualAvx512,   TransposeAvx2,
+    GemvAvx512,      GemvTAvx512, 8,             32,
+    GemmAvx512};
+#endif
+
+// Таблица ядер типа T для набора инструкций (nullptr - такого варианта нет)
+template <class T>
+const S21KernelsT<T> *Table(S21Isa isa);
+
+template <>
+const S21KernelsT<double> *Table<double>(S21Isa isa) {
+  switch (isa) {
+    case S21Isa::kScalar:
+      return &kScalarKernels<double>;
+#ifdef S21_X86
+    case S21Isa::kSse2:
+      return &kSse2Kernels;
+    case S21Isa::kAvx2:
+      return &kAvx2Kernels;
+    case S21Isa::kAvx512:
+      return &kAvx512Kernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+template <>
+const S21KernelsT<float> *Table<float>(S21Isa isa) {
+  switch (isa) {
+    case S21Isa::kScalar:
+      return &kScalarKernels<float>;
+#ifdef S21_X86
+    case S21Isa::kSse2:
+      return &kSse2FloatKernels;
+    case S21Isa::kAvx2:
+      return &kAvx2FloatKernels;
+    case S21Isa::kAvx512:
+      return &kAvx512FloatKernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+// long double хранится в формате x87, векторных инструкций для него нет
+template <>
+const S21KernelsT<long double> *Table<long double>(S21Isa isa) {
+  return isa == S21Isa::kScalar ? &kScalarKernels<long double> : nullptr;
+}
+
+bool Supported(S21Isa isa) {
+  bool result = isa == S21Isa::kScalar;
+#ifdef S21_X86
+  __builtin_cpu_init();
+  if (isa == S21Isa::kSse2) result = __builtin_cpu_supports("sse2");
+  if (isa == S21Isa::kAvx2)
+    result = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  if (isa == S21Isa::kAvx512) result = __builtin_cpu_supports("avx512f");
+#endif
+  return result;
+}
+
+template <class T>
+const S21KernelsT<T> &SelectKernels() {
+  const S21Isa isas[] = {S21Isa::kAvx512, S21Isa::kAvx2, S21Isa::kSse2};
+  for (S21Isa isa : isas)
+    if (const S21KernelsT<T> *kernels = S21GetKernels<T>(isa)) return *kernels;
+  return kScalarKernels<T>;
+}
+
+}  // namespace
+
+template <class T>
+const S21KernelsT<T> &S21GetKernels() {
+  static const S21KernelsT<T> &kernels = SelectKernels<T>();
+  return kernels;
+}
+
+template <class T>
+const S21KernelsT<T> *S21GetKernels(S21Isa isa) {
+  return Supported(isa) ? Table<T>(isa) : nullptr;
+}
+
+template const S21KernelsT<float> &S21GetKernels<float>();
+template const S21KernelsT<double> &S21GetKernels<double>();
+template const S21KernelsT<long double> &S21GetKernels<long double>();
+template const S21KernelsT<float> *S21GetKernels<float>(S21Isa isa);
+template const S21KernelsT<double> *S21GetKernels<double>(S21Isa isa);
+template const S21KernelsT<long double> *S21GetKernels<long double>(
+    S21Isa isa);
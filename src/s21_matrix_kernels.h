@@ -0,0 +1,59 @@
+#ifndef __S21MATRIX_KERNELS_H__
+#define __S21MATRIX_KERNELS_H__
+
+#include <cstddef>
+
+// Набор инструкций, под который собраны ядра
+enum class S21Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Микроядро GEMM: блок mr x nr из упакованных панелей A (kc x kMR) и
+// B (kc x kNR) записывается (или прибавляется) в C
+template <class T>
+using S21GemmMicroKernelT = void (*)(int kc, const T *a, const T *b, T *c,
+                                     int ldc, int mr, int nr,
+                                     bool accumulate);
+
+// Таблица векторизованных ядер для одного набора инструкций и типа
+// элементов T (float, double или long double).
+// Поэлементные ядра работают с непрерывными массивами из n элементов.
+template <class T>
+struct S21KernelsT {
+  S21Isa isa;
+  const char *name;
+
+  void (*add)(T *dst, const T *src, std::size_t n);  // dst += src
+  void (*sub)(T *dst, const T *src, std::size_t n);  // dst -= src
+  void (*scale)(T *dst, T num, std::size_t n);       // dst *= num
+  void (*zero)(T *dst, std::size_t n);               // dst = 0
+  // Сравнивает массивы и выходит на первом несовпадении
+  bool (*equal)(const T *a, const T *b, std::size_t n);
+  // Транспонирует блок rows x cols (шаг строки lds) в dst (cols x rows, шаг
+  // ldd); блоки регистровой ширины переставляются прямо в регистрах
+  void (*transpose)(const T *src, int lds, T *dst, int ldd, int rows,
+                    int cols);
+  // Матрица на вектор: y[i] = a[i, :] * x для rows строк из cols элементов
+  // (шаг строки lda). Четыре строки за проход используют одну загрузку x.
+  void (*gemv)(const T *a, int lda, const T *x, T *y, int rows, int cols);
+  // Вектор на матрицу: y[j] += x[i] * a[i, j]. Четыре строки за проход
+  // используют одну загрузку и запись y.
+  void (*gemv_t)(const T *a, int lda, const T *x, T *y, int rows, int cols);
+
+  int gemm_mr;  // Высота блока микроядра GEMM
+  int gemm_nr;  // Ширина блока микроядра GEMM
+  S21GemmMicroKernelT<T> gemm;
+};
+
+using S21Kernels = S21KernelsT<double>;
+using S21GemmMicroKernel = S21GemmMicroKernelT<double>;
+
+// Ядра для лучшего набора инструкций процессора (выбираются один раз по CPUID)
+template <class T = double>
+const S21KernelsT<T> &S21GetKernels();
+
+// Ядра для конкретного набора инструкций или nullptr, если процессор его не
+// поддерживает. Для long double векторных вариантов нет (x87), есть только
+// S21Isa::kScalar.
+template <class T = double>
+const S21KernelsT<T> *S21GetKernels(S21Isa isa);
+
+#endif
@@ -0,0 +1,280 @@
+#include "s21_matrix_lu.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_stats.h"
+
+namespace {
+
+// Ширина панели разложения и высота блока подстановки: панель n x kBlock и
+// блок правых частей помещаются в L2. Матрицы до kBlock включительно
+// считаются без блоков.
+constexpr int kBlock = 64;
+
+// При меньшем числе правых частей ход идёт по столбцам: строка B слишком
+// коротка, чтобы векторизовать операции над ней
+constexpr int kNarrowRhs = 8;
+
+// C (m x n) -= A (m x k) * B (k x n): знак B меняется на месте, и
+// произведение прибавляется блочным GEMM (он упаковывает операнды в свои
+// буферы потока), после чего знак возвращается. Смена знака точна, поэтому
+// B восстанавливается бит в бит без отдельной копии. Во всех вызовах B не
+// пересекается с A и C.
+template <class T>
+void GemmSub(int m, int n, int k, const T *a, int lda, T *b, int ldb, T *c,
+             int ldc) {
+  if (m == 0 || n == 0 || k == 0) return;
+  auto negate = [&] {
+    for (int p = 0; p < k; p++) {
+      T *row = b + (std::ptrdiff_t)p * ldb;
+      for (int j = 0; j < n; j++) row[j] = -row[j];
+    }
+  };
+  negate();
+  S21Gemm(m, n, k, a, lda, static_cast<const T *>(b), ldb, c, ldc, true);
+  negate();
+}
+
+// Скалярное произведение с восемью независимыми суммами: компилятор кладёт
+// их в векторные регистры, не меняя порядок сложений внутри каждой суммы
+template <class T>
+T Dot(const T *a, const T *b, int n) {
+  T acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    for (int l = 0; l < 8; l++) acc[l] += a[i + l] * b[i + l];
+  T sum = 0;
+  for (; i < n; i++) sum += a[i] * b[i];
+  for (int l = 0; l < 8; l++) sum += acc[l];
+  return sum;
+}
+
+// Разлагает панель - столбцы [k0, k1) в строках [k0, n): ведущий элемент
+// выбирается по столбцу, строки переставляются целиком, а исключение идёт
+// только внутри панели. Возвращает false, если матрица вырождена.
+template <class T>
+bool FactorPanel(T *a, int n, int lda, int k0, int k1, int *pivots,
+                 int &sign) {
+  for (int k = k0; k < k1; k++) {
+    int pivot = k;
+    T max = std::fabs(a[(std::ptrdiff_t)k * lda + k]);
+    for (int i = k + 1; i < n; i++) {
+      T value = std::fabs(a[(std::ptrdiff_t)i * lda + k]);
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    if (pivots) pivots[k] = pivot;
+    if (max == 0) return false;
+
+    if (pivot != k) {
+      T *row_k = a + (std::ptrdiff_t)k * lda;
+      T *row_p = a + (std::ptrdiff_t)pivot * lda;
+      for (int j = 0; j < n; j++) std::swap(row_k[j], row_p[j]);
+      sign = -sign;
+    }
+
+    const T *row_k = a + (std::ptrdiff_t)k * lda;
+    T inv_pivot = 1 / row_k[k];
+    for (int i = k + 1; i < n; i++) {
+      T *row_i = a + (std::ptrdiff_t)i * lda;
+      T l = row_i[k] * inv_pivot;
+      row_i[k] = l;
+      for (int j = k + 1; j < k1; j++) row_i[j] -= l * row_k[j];
+    }
+  }
+  return true;
+}
+
+// Прямой ход с единичной нижнетреугольной L[k0:k1, k0:k1] для строк
+// [k0, k1) матрицы b: строки обновляются целиком, цикл по столбцам
+// векторизуется
+template <class T>
+void ForwardRows(const T *lu, int ldlu, int k0, int k1, T *b, int cols,
+                 int ldb) {
+  for (int i = k0 + 1; i < k1; i++) {
+    T *row_i = b + (std::ptrdiff_t)i * ldb;
+    for (int k = k0; k < i; k++) {
+      T l = lu[(std::ptrdiff_t)i * ldlu + k];
+      if (l == 0) continue;
+      const T *row_k = b + (std::ptrdiff_t)k * ldb;
+      for (int j = 0; j < cols; j++) row_i[j] -= l * row_k[j];
+    }
+  }
+}
+
+// Обратный ход с верхнетреугольной U[k0:k1, k0:k1] для строк [k0, k1)
+template <class T>
+void BackwardRows(const T *lu, int ldlu, int k0, int k1, T *b, int cols,
+                  int ldb) {
+  for (int i = k1 - 1; i >= k0; i--) {
+    T *row_i = b + (std::ptrdiff_t)i * ldb;
+    for (int k = i + 1; k < k1; k++) {
+      T u = lu[(std::ptrdiff_t)i * ldlu + k];
+      if (u == 0) continue;
+      const T *row_k = b + (std::ptrdiff_t)k * ldb;
+      for (int j = 0; j < cols; j++) row_i[j] -= u * row_k[j];
+    }
+    T diagonal = lu[(std::ptrdiff_t)i * ldlu + i];
+    for (int j = 0; j < cols; j++) row_i[j] /= diagonal;
+  }
+}
+
+// Прямой и обратный ход для одного столбца x (непрерывного)
+template <class T>
+void SolveColumn(const T *lu, int n, int ldlu, T *x) {
+  for (int i = 1; i < n; i++) x[i] -= Dot(lu + (std::ptrdiff_t)i * ldlu, x, i);
+  for (int i = n - 1; i >= 0; i--) {
+    const T *row_i = lu + (std::ptrdiff_t)i * ldlu;
+    x[i] = (x[i] - Dot(row_i + i + 1, x + i + 1, n - i - 1)) / row_i[i];
+  }
+}
+
+}  // namespace
+
+// Панель [k0, k1) разлагается FactorPanel, затем строки панели справа от
+// неё решаются с L панели (блок U12), и остаток A22 -= L21 * U12
+template <class T>
+int S21LuDecompose(T *a, int n, int lda, int *pivots) {
+  int sign = 1;
+
+  for (int k0 = 0; k0 < n; k0 += kBlock) {
+    int k1 = (n - k0 < kBlock) ? n : k0 + kBlock;
+    if (!FactorPanel(a, n, lda, k0, k1, pivots, sign)) return 0;
+    if (k1 == n) break;
+
+    T *u12 = a + (std::ptrdiff_t)k0 * lda + k1;
+    ForwardRows(a, lda, k0, k1, a + k1, n - k1, lda);
+    GemmSub(n - k1, n - k1, k1 - k0, a + (std::ptrdiff_t)k1 * lda + k0, lda,
+            u12, lda, a + (std::ptrdiff_t)k1 * lda + k1, lda);
+  }
+
+  return sign;
+}
+
+template <class T>
+void S21LuSolve(const T *lu, int n, int ldlu, const int *pivots, T *b,
+                int nrhs, int ldb) {
+  for (int k = 0; k < n; k++) {
+    if (pivots[k] != k) {
+      T *row_k = b + (std::ptrdiff_t)k * ldb;
+      T *row_p = b + (std::ptrdiff_t)pivots[k] * ldb;
+      for (int j = 0; j < nrhs; j++) std::swap(row_k[j], row_p[j]);
+    }
+  }
+
+  if (nrhs < kNarrowRhs) {
+    // Столбец B переписывается в непрерывный буфер и обратно
+    std::vector<T> x(n);
+    for (int j = 0; j < nrhs; j++) {
+      for (int i = 0; i < n; i++) x[i] = b[(std::ptrdiff_t)i * ldb + j];
+      SolveColumn(lu, n, ldlu, x.data());
+      for (int i = 0; i < n; i++) b[(std::ptrdiff_t)i * ldb + j] = x[i];
+    }
+  } else if (n <= kBlock) {
+    ForwardRows(lu, ldlu, 0, n, b, nrhs, ldb);
+    BackwardRows(lu, ldlu, 0, n, b, nrhs, ldb);
+  } else {
+    // Блок строк решается построчно, остальные строки обновляются GEMM
+    for (int k0 = 0; k0 < n; k0 += kBlock) {
+      int k1 = (n - k0 < kBlock) ? n : k0 + kBlock;
+      ForwardRows(lu, ldlu, k0, k1, b, nrhs, ldb);
+      GemmSub(n - k1, nrhs, k1 - k0, lu + (std::ptrdiff_t)k1 * ldlu + k0,
+              ldlu, b + (std::ptrdiff_t)k0 * ldb, ldb,
+              b + (std::ptrdiff_t)k1 * ldb, ldb);
+    }
+    for (int k1 = n; k1 > 0; k1 -= kBlock) {
+      int k0 = (k1 < kBlock) ? 0 : k1 - kBlock;
+      BackwardRows(lu, ldlu, k0, k1, b, nrhs, ldb);
+      GemmSub(k0, nrhs, k1 - k0, lu + k0, ldlu, b + (std::ptrdiff_t)k0 * ldb,
+              ldb, b, ldb);
+    }
+  }
+}
+
+// S21LUT
+
+template <class T>
+S21LUT<T>::S21LUT(const S21MatrixT<T> &matrix)
+    : lu_(matrix), pivots_(lu_.GetRows()), sign_(0) {
+  if (lu_.GetRows() != lu_.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input: you can't get a LU decomposition for matrix that is "
+        "not square.");
+  }
+  int n = lu_.GetRows();
+  S21_STATS_SCOPE(kLu, n, n, 2.0 / 3 * n * n * n);
+  sign_ = S21LuDecompose(lu_.WritableData(), n, lu_.Stride(), pivots_.data());
+}
+
+template <class T>
+int S21LUT<T>::Size() const {
+  return (int)pivots_.size();
+}
+
+template <class T>
+bool S21LUT<T>::Singular() const {
+  return sign_ == 0;
+}
+
+template <class T>
+T S21LUT<T>::Determinant() const {
+  T det = sign_;
+  const T *lu = lu_.Data();
+  for (int k = 0; k < Size() && sign_ != 0; k++)
+    det *= lu[(std::ptrdiff_t)k * lu_.Stride() + k];
+  return det;
+}
+
+template <class T>
+S21MatrixT<T> S21LUT<T>::Solve(const S21MatrixT<T> &b) const {
+  S21MatrixT<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <class T>
+void S21LUT<T>::SolveInPlace(S21MatrixT<T> &b) const {
+  CheckSolvable(b.GetRows());
+  int n = Size(), nrhs = b.GetCols();
+  S21_STATS_SCOPE(kSolve, n, nrhs, 2.0 * n * n * nrhs);
+  S21LuSolve(lu_.Data(), n, lu_.Stride(), pivots_.data(), b.WritableData(),
+             nrhs, b.Stride());
+}
+
+template <class T>
+S21MatrixT<T> S21LUT<T>::Inverse() const {
+  int n = Size();
+  S21MatrixT<T> inverse(n, n);
+  for (int k = 0; k < n; k++) inverse.SetValue(k, k, 1);
+  SolveInPlace(inverse);
+  return inverse;
+}
+
+template <class T>
+void S21LUT<T>::CheckSolvable(int rows) const {
+  if (rows != Size()) {
+    throw std::out_of_range(
+        "Incorrect input: right-hand side should have as many rows as the "
+        "matrix.");
+  }
+  if (Singular()) {
+    throw std::out_of_range(
+        "Incorrect input: you can't solve a system if the matrix determinant "
+        "is equal to zero.");
+  }
+}
+
+#define S21_LU_INSTANTIATE(T)                                               \
+  template int S21LuDecompose(T *, int, int, int *);                        \
+  template void S21LuSolve(const T *, int, int, const int *, T *, int, int); \
+  template class S21LUT<T>;
+
+S21_LU_INSTANTIATE(float)
+S21_LU_INSTANTIATE(double)
+S21_LU_INSTANTIATE(long double)
@@ -0,0 +1,63 @@
+#ifndef __S21MATRIX_LU_H__
+#define __S21MATRIX_LU_H__
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU-разложение с частичным выбором ведущего элемента и решение систем
+// линейных уравнений A X = B.
+//
+// Все матрицы хранятся построчно, ld* - шаг строки в элементах. Матрицы
+// порядка больше 64 разлагаются блоками: панель из 64 столбцов разлагается
+// построчно, а остаток матрицы обновляется блочным GEMM
+// (s21_matrix_gemm.h). Так же устроены прямой и обратный ход при многих
+// правых частях; при одной-нескольких правых частях ход идёт по столбцам
+// векторизованными скалярными произведениями. Определено для float, double
+// и long double.
+
+// Разлагает квадратную матрицу a порядка n на месте: P A = L U. Под
+// диагональю остаются множители L (с единичной диагональю), на диагонали и
+// выше - U. В pivots (если не nullptr) записывается номер строки, с которой
+// переставлялась k-я строка. Возвращает знак перестановки (+1/-1) или 0,
+// если матрица вырождена (тогда разложение прерывается).
+template <class T>
+int S21LuDecompose(T *a, int n, int lda, int *pivots);
+
+// Решает A X = B по разложению из S21LuDecompose: B (n x nrhs) заменяется
+// на X
+template <class T>
+void S21LuSolve(const T *lu, int n, int ldlu, const int *pivots, T *b,
+                int nrhs, int ldb);
+
+// Разложение квадратной матрицы, которое считается один раз и затем
+// решает системы с любым числом правых частей за O(n^2) на столбец.
+// Исходная матрица не хранится: разложение - её копия.
+template <class T>
+class S21LUT {
+ public:
+  explicit S21LUT(const S21MatrixT<T> &matrix);  // Разлагает матрицу
+
+  int Size() const;        // Порядок матрицы
+  bool Singular() const;   // Матрица вырождена, решать системы нельзя
+  T Determinant() const;   // Определитель (0 для вырожденной матрицы)
+  S21MatrixT<T> Solve(const S21MatrixT<T> &b) const;  // Возвращает X
+  void SolveInPlace(S21MatrixT<T> &b) const;  // Записывает X на место B
+  S21MatrixT<T> Inverse() const;  // Обратная матрица (решение A X = E)
+
+ private:
+  // Бросает std::out_of_range, если систему с rows строками решить нельзя
+  void CheckSolvable(int rows) const;
+
+  S21MatrixT<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;  // Знак перестановки или 0 для вырожденной матрицы
+};
+
+using S21LU = S21LUT<double>;
+
+extern template class S21LUT<float>;
+extern template class S21LUT<double>;
+extern template class S21LUT<long double>;
+
+#endif
@@ -1,270 +1,537 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_thread_pool.h"
+
+namespace {
+
+// Разлагает матрицу через S21LuDecompose и возвращает её определитель
+template <class T>
+T LuDeterminant(T *a, int n, int lda, int *pivots) {
+  int sign = S21LuDecompose(a, n, lda, pivots);
+  T det = sign;
+  for (int k = 0; k < n && sign != 0; k++)
+    det *= a[(std::ptrdiff_t)k * lda + k];
+  return det;
+}
+
+// Определитель без сохранения разложения: a копируется в единственный
+// рабочий буфер и разлагается в нём на месте, без массива перестановок
+template <class T>
+T ScratchDeterminant(S21MatrixViewT<const T> a) {
+  int n = a.GetRows();
+  S21_STATS_SCOPE(kLu, n, n, 2.0 / 3 * n * n * n);
+  S21MatrixT<T> scratch(n, n);
+  T *data = scratch.Data();
+  S21MatrixViewT<T>(data, n, n, scratch.Stride()).Assign(a);
+  return LuDeterminant(data, n, scratch.Stride(), nullptr);
+}
+
+// Копирует минор a (без строки oy и столбца ox) в dst четырьмя блоками,
+// которые лежат по разные стороны от вычёркнутых строки и столбца
+template <class T>
+void CopyMinor(S21MatrixViewT<const T> a, int oy, int ox,
+               S21MatrixViewT<T> dst) {
+  int below = a.GetRows() - oy - 1, right = a.GetCols() - ox - 1;
+  dst.Block(0, 0, oy, ox).Assign(a.Block(0, 0, oy, ox));
+  dst.Block(0, ox, oy, right).Assign(a.Block(0, ox + 1, oy, right));
+  dst.Block(oy, 0, below, ox).Assign(a.Block(oy + 1, 0, below, ox));
+  dst.Block(oy, ox, below, right)
+      .Assign(a.Block(oy + 1, ox + 1, below, right));
+}
+
+}  // namespace
+
 // КОНСТРУКТОРЫ И ДЕСТРУКТОР
 
 // Базовый конструктор, инициализирующий матрицу некоторой заранее заданной
 // размерностью
-S21Matrix::S21Matrix() {
-  rows_ = 3;
-  cols_ = 3;
-
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; i++) matrix_[i] = new double[cols_];
-
+template <class T>
+S21MatrixT<T>::S21MatrixT()
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_rows_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  Allocate(3, 3);
   FillMatrixByZero();
 }
 
 // Параметризированный конструктор с количеством строк и столбцов
-S21Matrix::S21Matrix(int rows, int cols) {
+template <class T>
+S21MatrixT<T>::S21MatrixT(int rows, int cols)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_rows_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
   if (rows <= 0 || cols <= 0) {
     throw std::out_of_range("Incorrect input, index is out of range.");
   } else {
-    rows_ = rows;
-    cols_ = cols;
-
-    matrix_ = new double *[rows_];
-    for (int i = 0; i < rows_; i++) matrix_[i] = new double[cols_];
-
+    Allocate(rows, cols);
     FillMatrixByZero();
   }
 }
 
 // Конструктор копирования
-S21Matrix::S21Matrix(const S21Matrix &other) { CopyMatrix(other); }
+template <class T>
+S21MatrixT<T>::S21MatrixT(const S21MatrixT &other)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_rows_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  CopyMatrix(other);
+}
 
 // Конструктор переноса
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept {
+template <class T>
+S21MatrixT<T>::S21MatrixT(S21MatrixT &&other) noexcept {
   matrix_ = other.matrix_;
   rows_ = other.rows_;
   cols_ = other.cols_;
-
+  stride_ = other.stride_;
+  capacity_rows_ = other.capacity_rows_;
+  allocator_ = other.allocator_;
+  cache_ = std::move(other.cache_);
+  exposed_ = other.exposed_;
+
+  other.matrix_ = nullptr;
+  other.cache_ = Cache();  // Перенесённый optional остаётся заполненным
+  other.exposed_ = false;
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
+  other.capacity_rows_ = 0;
+  other.allocator_ = nullptr;
 }
 
 // Деструктор
-S21Matrix::~S21Matrix() { Free(); }
+template <class T>
+S21MatrixT<T>::~S21MatrixT() { Free(); }
 
 // МЕТОДЫ
 
 // Сравнивает матрицы на равенство
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) {
+template <class T>
+bool S21MatrixT<T>::EqMatrix(const S21MatrixT &other) {
+  S21_STATS_SCOPE(kEqMatrix, rows_, cols_, 0);
   bool result = true;
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     result = false;
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (matrix_[i][j] != other.matrix_[i][j]) {
-          result = false;
-          break;
-        }
-      }
+    const S21KernelsT<T> &kernels = S21GetKernels<T>();
+    for (int i = 0; i < rows_ && result; i++) {
+      result = kernels.equal(&At(i, 0), &other.At(i, 0), cols_);
     }
   }
   return result;
 }
 
 // Складывает матрицы
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <class T>
+void S21MatrixT<T>::SumMatrix(const S21MatrixT &other) {
+  S21_STATS_SCOPE(kSumMatrix, rows_, cols_, (double)rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::out_of_range(
         "Incorrect input: matriсes should have the same "
         "size if you want to sum them.");
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
+    // Без выравнивающих хвостов буфер обходится целиком, иначе - по строкам,
+    // чтобы хвосты оставались нулями
+    MakeWritable();
+    const S21KernelsT<T> &kernels = S21GetKernels<T>();
+    ForEachRowRange([&](int lo, int hi) {
+      if (stride_ == cols_ && other.stride_ == cols_) {
+        kernels.add(&At(lo, 0), &other.At(lo, 0),
+                  (std::size_t)(hi - lo) * stride_);
+      } else {
+        for (int i = lo; i < hi; i++)
+          kernels.add(&At(i, 0), &other.At(i, 0), cols_);
       }
-    }
+    });
   }
 }
 
 // Вычитает матрицы
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <class T>
+void S21MatrixT<T>::SubMatrix(const S21MatrixT &other) {
+  S21_STATS_SCOPE(kSubMatrix, rows_, cols_, (double)rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::out_of_range(
         "Incorrect input: matriсes should have the same "
         "size if you want to sum them.");
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
+    // Без выравнивающих хвостов буфер обходится целиком, иначе - по строкам,
+    // чтобы хвосты оставались нулями
+    MakeWritable();
+    const S21KernelsT<T> &kernels = S21GetKernels<T>();
+    ForEachRowRange([&](int lo, int hi) {
+      if (stride_ == cols_ && other.stride_ == cols_) {
+        kernels.sub(&At(lo, 0), &other.At(lo, 0),
+                  (std::size_t)(hi - lo) * stride_);
+      } else {
+        for (int i = lo; i < hi; i++)
+          kernels.sub(&At(i, 0), &other.At(i, 0), cols_);
       }
-    }
+    });
   }
 }
 
 // Умножает матрицу на число
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = matrix_[i][j] * num;
+template <class T>
+void S21MatrixT<T>::MulNumber(const T num) {
+  S21_STATS_SCOPE(kMulNumber, rows_, cols_, (double)rows_ * cols_);
+  MakeWritable();
+  const S21KernelsT<T> &kernels = S21GetKernels<T>();
+  ForEachRowRange([&](int lo, int hi) {
+    if (stride_ == cols_) {
+      kernels.scale(&At(lo, 0), num, (std::size_t)(hi - lo) * stride_);
+    } else {
+      for (int i = lo; i < hi; i++) kernels.scale(&At(i, 0), num, cols_);
     }
-  }
+  });
 }
 
 // Умножает матрицы
-void S21Matrix::MulMatrix(const S21Matrix &other) {
+template <class T>
+void S21MatrixT<T>::MulMatrix(const S21MatrixT &other, S21MulPolicy policy) {
   if (cols_ != other.rows_) {
     throw std::out_of_range(
         "Incorrect input. Number of first matrix columns "
         "should be equal for second matrix rows");
   } else {
-    S21Matrix result(this->rows_, other.cols_);
-    for (int i = 0; i < result.rows_; i++) {
-      for (int j = 0; j < result.cols_; j++) {
-        for (int k = 0; k < this->cols_; k++) {
-          result.matrix_[i][j] += (this->matrix_[i][k] * other.matrix_[k][j]);
-        }
-      }
-    }
-    this->Free();
-    *this = std::move(result);
+    *this = Product(other, policy);
   }
 }
 
-// Создает новую транспонированную матрицу из текущей и возвращает её
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
+template <class T>
+std::vector<T> S21MatrixT<T>::MulVector(const std::vector<T> &x) const {
+  if ((int)x.size() != cols_) {
+    throw std::out_of_range(
+        "Incorrect input. Vector size should be equal to the number of "
+        "matrix columns");
+  }
+  std::vector<T> y(rows_);
+  MulVector(x.data(), y.data());
+  return y;
+}
 
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) result.matrix_[j][i] = matrix_[i][j];
+template <class T>
+void S21MatrixT<T>::MulVector(const T *x, T *y) const {
+  S21_STATS_SCOPE(kMulVector, rows_, cols_, 2.0 * rows_ * cols_);
+  S21Gemv(rows_, cols_, matrix_, stride_, x, y);
+}
+
+template <class T>
+std::vector<T> S21MatrixT<T>::VectorMul(const std::vector<T> &x) const {
+  if ((int)x.size() != rows_) {
+    throw std::out_of_range(
+        "Incorrect input. Vector size should be equal to the number of "
+        "matrix rows");
+  }
+  std::vector<T> y(cols_);
+  VectorMul(x.data(), y.data());
+  return y;
+}
+
+template <class T>
+void S21MatrixT<T>::VectorMul(const T *x, T *y) const {
+  S21_STATS_SCOPE(kMulVector, rows_, cols_, 2.0 * rows_ * cols_);
+  S21GemvT(rows_, cols_, matrix_, stride_, x, y);
+}
+
+// Создает новую транспонированную матрицу из текущей и возвращает её
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::Transpose() {
+  S21_STATS_SCOPE(kTranspose, rows_, cols_, 0);
+  S21MatrixT result(cols_, rows_);
+  const S21KernelsT<T> &kernels = S21GetKernels<T>();
+
+  // Плитки kTransposeTile x kTransposeTile: и чтение, и запись идут по
+  // нескольким строкам, которые целиком лежат в кэше
+  ForEachRowRange([&](int lo, int hi) {
+    for (int i = lo; i < hi; i += kTransposeTile) {
+      int h = std::min(kTransposeTile, hi - i);
+      for (int j = 0; j < cols_; j += kTransposeTile) {
+        int w = std::min(kTransposeTile, cols_ - j);
+        kernels.transpose(&At(i, j), stride_, &result.At(j, i), result.stride_,
+                          h, w);
+      }
+    }
+  });
 
   return result;
 }
 
-// Вычисляет матрицу алгебраических дополнений текущей матрицы и возвращает ее
-S21Matrix S21Matrix::CalcComplements() {
-  S21Matrix result(rows_, cols_);
-  double det = Determinant();
+// Транспонирует квадратную матрицу на месте. Блоки (i, j) и (j, i) размером
+// kTransposeBlock транспонируются во временные массивы на стеке и
+// записываются на места друг друга.
+template <class T>
+void S21MatrixT<T>::TransposeInPlace() {
+  S21_STATS_SCOPE(kTransposeInPlace, rows_, cols_, 0);
+  if (rows_ != cols_) {
+    throw std::out_of_range(
+        "Incorrect input: you can't transpose in place matrix that is not "
+        "square.");
+  }
+
+  MakeWritable();
+  constexpr int kBlock = kTransposeBlock;
+  const S21KernelsT<T> &kernels = S21GetKernels<T>();
+
+  // Каждая полоса блоков i обрабатывает пары (i, j) с j >= i, поэтому
+  // разные полосы не пересекаются и делятся между потоками
+  ForEachRowRange([&](int lo, int hi) {
+    alignas(kAlignment) T upper[kBlock * kBlock];
+    alignas(kAlignment) T lower[kBlock * kBlock];
+    for (int i = (lo + kBlock - 1) / kBlock * kBlock; i < hi; i += kBlock) {
+      int h = std::min(kBlock, rows_ - i);
+      for (int j = i; j < cols_; j += kBlock) {
+        int w = std::min(kBlock, cols_ - j);
+        kernels.transpose(&At(i, j), stride_, upper, kBlock, h, w);
+        if (j != i) {
+          kernels.transpose(&At(j, i), stride_, lower, kBlock, w, h);
+          for (int y = 0; y < h; y++)
+            std::memcpy(&At(i + y, j), lower + y * kBlock, w * sizeof(T));
+        }
+        for (int y = 0; y < w; y++)
+          std::memcpy(&At(j + y, i), upper + y * kBlock, h * sizeof(T));
+      }
+    }
+  });
+}
 
+// Вычисляет матрицу алгебраических дополнений текущей матрицы и возвращает ее.
+// Операции разложения и обращения учитываются там, где они действительно
+// выполняются, а не при попадании в кэш.
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::CalcComplements() {
+  S21_STATS_SCOPE(kCalcComplements, rows_, cols_, rows_ == 3 ? 27.0 : 0.0);
   if (rows_ != cols_) {
     throw std::out_of_range(
         "Incorrect input: you can't get a complements matrix for matrix that "
         "is not square.");
-  } else if (det == 0) {
-    throw std::out_of_range(
-        "Incorrect input: you can't get a complements matrix for matrix which "
-        "determinant is zero.");
-  } else {
-    double minor_det = 0;
-
-    for (int i = 0; i < rows_; i++)
-      for (int j = 0; j < cols_; j++) {
-        S21Matrix minor = GetMinor(i, j);
-        minor_det = minor.Determinant();
-        minor.Free();
-        result.matrix_[i][j] = minor_det * pow(-1, i + j);
+  }
+
+  DropExposedCache();
+  S21MatrixT result(rows_, cols_);
+  if (rows_ == 1) {
+    result.At(0, 0) = 1;
+  } else if (rows_ == 2) {
+    result.At(0, 0) = At(1, 1);
+    result.At(0, 1) = -At(1, 0);
+    result.At(1, 0) = -At(0, 1);
+    result.At(1, 1) = At(0, 0);
+  } else if (rows_ == 3) {
+    // При циклическом обходе индексов знак (-1)^(i+j) учитывается сам
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        result.At(i, j) = At(i1, j1) * At(i2, j2) - At(i1, j2) * At(i2, j1);
       }
+  } else {
+    // Для невырожденной матрицы adj(A) = det(A) * A^(-1), а матрица
+    // дополнений - её транспонированная
+    T det = Factorization().Determinant();
+    if (det != 0) {
+      const S21MatrixT &inverse = CachedInverse();
+      S21_STATS_FLOPS((double)rows_ * cols_);
+      for (int i = 0; i < rows_; i++)
+        for (int j = 0; j < cols_; j++)
+          result.At(i, j) = det * inverse.At(j, i);
+    } else {
+      ComplementsByMinors(result);
+    }
   }
 
   return result;
 }
 
-// Вычисляет и возвращает определитель текущей матрицы
-double S21Matrix::Determinant() {
-  double result;
+// Вычисляет и возвращает определитель текущей матрицы. Готовое разложение
+// из кэша используется повторно; иначе матрица разлагается в одном рабочем
+// буфере, и запоминается только определитель. Операции LU учитываются,
+// только если разложение действительно считается.
+template <class T>
+T S21MatrixT<T>::Determinant() {
+  S21_STATS_SCOPE(kDeterminant, rows_, cols_, rows_ == 2 ? 3.0 : 0.0);
+  T result;
 
   if (rows_ != cols_) {
     throw std::out_of_range(
         "Incorrect input: you can't get a determinant for matrix that is not "
         "square.");
   } else if (rows_ == 1) {
-    result = matrix_[0][0];
+    result = At(0, 0);
   } else if (rows_ == 2) {
-    result = (matrix_[0][0] * matrix_[1][1]) - (matrix_[1][0] * matrix_[0][1]);
+    result = (At(0, 0) * At(1, 1)) - (At(1, 0) * At(0, 1));
   } else {
-    double minor_det = 0;
-    result = 0;
-
-    for (int x = 0; x < cols_; x++) {
-      // Идём по первой строке, четвёртый параметр - вычёркиваемый столбец.
-      S21Matrix minor = GetMinor(0, x);
-      minor_det = minor.Determinant();
-      minor.Free();
-
-      if (x % 2 == 0)
-        result += (matrix_[0][x] * minor_det);
-      else
-        result -= (matrix_[0][x] * minor_det);
+    DropExposedCache();
+    if (!cache_.determinant && cache_.lu) {
+      cache_.determinant = cache_.lu->Determinant();
+    } else if (!cache_.determinant) {
+      S21_STATS_FLOPS(2.0 / 3 * rows_ * rows_ * rows_);
+      cache_.determinant = ScratchDeterminant(std::as_const(*this).View());
     }
+    result = *cache_.determinant;
   }
 
   return result;
 }
 
 // Вычисляет и возвращает обратную матрицу
-S21Matrix S21Matrix::InverseMatrix() {
-  S21Matrix result(rows_, cols_);
-
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::InverseMatrix() {
+  S21_STATS_SCOPE(kInverseMatrix, rows_, cols_, 0);
   if (rows_ != cols_) {
-    std::out_of_range(
+    throw std::out_of_range(
         "Incorrect input: you can't inverse matrix that is not square.");
-  } else {
-    double det = Determinant();
-    if (det == 0) {
-      std::out_of_range(
-          "Incorrect input: you can't inverse matrix if it's determinant is "
-          "equal to zero.");
-    } else {
-      S21Matrix complem = CalcComplements();
-      S21Matrix transp = complem.Transpose();
-      transp.MulNumber(1.0 / det);
-
-      result = std::move(transp);
-
-      complem.Free();
-      transp.Free();
-    }
   }
 
-  return result;
+  DropExposedCache();
+  return CachedInverse();
+}
+
+// Решает систему A X = B (A - текущая матрица) через LU-разложение
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::Solve(const S21MatrixT &other) {
+  DropExposedCache();
+  return Factorization().Solve(other);
 }
 
 // ПЕРЕГРУЗКА ОПЕРАТОРОВ
 
-// Сложение двух матриц
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  S21Matrix result = *this;
-  result.SumMatrix(other);
+// Сложение двух матриц (ленивое, размеры проверяются сразу)
+template <class T>
+S21MatrixSumExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>>
+S21MatrixT<T>::operator+(const S21MatrixT &other) const & {
+  return S21MatrixSumExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>>(Leaf(),
+                                                                 other.Leaf());
+}
+
+// Сложение с временной матрицей: результат пишется в её буфер
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator+(S21MatrixT &&other) const & {
+  other.SumMatrix(*this);
 
-  return result;
+  return std::move(other);
 }
 
-// Вычитание одной матрицы из другой
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  S21Matrix result = *this;
-  result.SubMatrix(other);
+// Сложение, когда текущая матрица временная: результат пишется в её буфер
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator+(const S21MatrixT &other) && {
+  SumMatrix(other);
 
-  return result;
+  return std::move(*this);
+}
+
+// Обе матрицы временные: результат пишется в буфер левой
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator+(S21MatrixT &&other) && {
+  SumMatrix(other);
+
+  return std::move(*this);
+}
+
+// Вычитание одной матрицы из другой (ленивое, размеры проверяются сразу)
+template <class T>
+S21MatrixSubExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>>
+S21MatrixT<T>::operator-(const S21MatrixT &other) const & {
+  return S21MatrixSubExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>>(Leaf(),
+                                                                 other.Leaf());
+}
+
+// Вычитание временной матрицы: разность пишется в её буфер
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator-(S21MatrixT &&other) const & {
+  other = *this - other;
+
+  return std::move(other);
+}
+
+// Вычитание из временной матрицы: разность пишется в её буфер
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator-(const S21MatrixT &other) && {
+  SubMatrix(other);
+
+  return std::move(*this);
+}
+
+// Обе матрицы временные: результат пишется в буфер левой
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator-(S21MatrixT &&other) && {
+  SubMatrix(other);
+
+  return std::move(*this);
 }
 
 // Умножение матриц
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  S21Matrix result = *this;
-  result.MulMatrix(other);
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator*(const S21MatrixT &other) const & {
+  if (cols_ != other.rows_) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
 
-  return result;
+  return Product(other);
 }
 
-// Умножение матрицы на число
-S21Matrix S21Matrix::operator*(const double num) {
-  S21Matrix result = *this;
-  result.MulNumber(num);
+// Умножение временной матрицы: её буфер освобождается сразу после умножения
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator*(const S21MatrixT &other) && {
+  MulMatrix(other);
 
-  return result;
+  return std::move(*this);
+}
+
+// Умножение матрицы на число (ленивое)
+template <class T>
+S21MatrixScaleExpr<S21MatrixLeafT<T>> S21MatrixT<T>::operator*(
+    const T num) const & {
+  return S21MatrixScaleExpr<S21MatrixLeafT<T>>(Leaf(), num);
+}
+
+// Умножение временной матрицы на число на месте
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::operator*(const T num) && {
+  MulNumber(num);
+
+  return std::move(*this);
 }
 
 // Проверка на равенство матриц (EqMatrix)
-bool S21Matrix::operator==(const S21Matrix &other) {
+template <class T>
+bool S21MatrixT<T>::operator==(const S21MatrixT &other) {
   return (this->EqMatrix(other));
 }
 
-// Присвоение матрице значений другой матрицы
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
-  if (!(*this == other)) {
+// Присвоение матрице значений другой матрицы. Буфер того же размера
+// переиспользуется без повторного выделения памяти.
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator=(const S21MatrixT &other) {
+  if (this == &other) {
+    // do nothing
+  } else if (other.rows_ <= capacity_rows_ && stride_ == other.stride_ &&
+             matrix_ && Writable()) {
+    // Буфер достаточной ёмкости переиспользуется
+    Invalidate();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    std::memcpy(matrix_, other.matrix_,
+                (std::size_t)rows_ * stride_ * sizeof(T));
+    if (!other.exposed_) cache_ = other.cache_;
+  } else {
+    Invalidate();
     Free();
     CopyMatrix(other);
   }
@@ -272,181 +539,671 @@ S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
   return *this;
 }
 
+// Перенос: буфер other забирается целиком, other становится пустой
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator=(S21MatrixT &&other) noexcept {
+  if (this != &other) {
+    Invalidate();
+    Free();
+    Swap(other);
+  }
+
+  return *this;
+}
+
 // Присвоение сложения (SumMatrix)
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator+=(const S21MatrixT &other) {
   this->SumMatrix(other);
 
   return *this;
 }
 
 // Присвоение разности (SubMatrix)
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator-=(const S21MatrixT &other) {
   this->SubMatrix(other);
 
   return *this;
 }
 
 // Присвоение умножения (MulMatrix)
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator*=(const S21MatrixT &other) {
   this->MulMatrix(other);
 
   return *this;
 }
 
 // Присвоение умножения (MulNumber)
-S21Matrix &S21Matrix::operator*=(const double num) {
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::operator*=(const T num) {
   this->MulNumber(num);
 
   return *this;
 }
 
 // Индексация по элементам матрицы (строка, колонка)
-double S21Matrix::operator()(int i, int j) {
+template <class T>
+T S21MatrixT<T>::operator()(int i, int j) {
   if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
     throw std::out_of_range("Incorrect input, index is out of range.");
   }
 
-  return matrix_[i][j];
+  return At(i, j);
 }
 
 // Accessors и mutators
 
-int S21Matrix::GetRows() { return rows_; }
+template <class T>
+int S21MatrixT<T>::GetRows() const { return rows_; }
+
+template <class T>
+int S21MatrixT<T>::GetCols() const { return cols_; }
+
+template <class T>
+T *S21MatrixT<T>::Data() {
+  exposed_ = true;
+  return WritableData();
+}
+
+template <class T>
+const T *S21MatrixT<T>::Data() const { return matrix_; }
+
+template <class T>
+int S21MatrixT<T>::Stride() const { return stride_; }
+
+template <class T>
+S21MatrixLeafT<T> S21MatrixT<T>::Leaf() const {
+  return S21MatrixLeafT<T>(matrix_, stride_, rows_, cols_);
+}
+
+template <class T>
+S21MatrixViewT<T> S21MatrixT<T>::View() {
+  exposed_ = true;
+  return WritableView();
+}
+
+template <class T>
+S21MatrixViewT<const T> S21MatrixT<T>::View() const {
+  return S21MatrixViewT<const T>(matrix_, rows_, cols_, stride_);
+}
+
+template <class T>
+S21MatrixViewT<T> S21MatrixT<T>::Block(int row, int col, int rows, int cols) {
+  return View().Block(row, col, rows, cols);
+}
+
+template <class T>
+S21MatrixViewT<const T> S21MatrixT<T>::Block(int row, int col, int rows,
+                                             int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <class T>
+S21MatrixViewT<T> S21MatrixT<T>::Row(int row) {
+  return View().Row(row);
+}
+
+template <class T>
+S21MatrixViewT<const T> S21MatrixT<T>::Row(int row) const {
+  return View().Row(row);
+}
+
+template <class T>
+S21MatrixViewT<T> S21MatrixT<T>::Col(int col) {
+  return View().Col(col);
+}
+
+template <class T>
+S21MatrixViewT<const T> S21MatrixT<T>::Col(int col) const {
+  return View().Col(col);
+}
+
+template <class T>
+S21MatrixAllocator *S21MatrixT<T>::Allocator() const { return allocator_; }
+
+template <class T>
+std::uint64_t S21MatrixT<T>::Version() const { return version_; }
+
+template <class T>
+S21MatrixIteratorT<T> S21MatrixT<T>::begin() {
+  MakeWritable();
+  exposed_ = true;
+  return S21MatrixIteratorT<T>(matrix_, cols_, stride_, 0, 0);
+}
+
+template <class T>
+S21MatrixIteratorT<T> S21MatrixT<T>::end() {
+  MakeWritable();
+  exposed_ = true;
+  return S21MatrixIteratorT<T>(matrix_, cols_, stride_, rows_, 0);
+}
+
+template <class T>
+S21MatrixIteratorT<const T> S21MatrixT<T>::begin() const {
+  return S21MatrixIteratorT<const T>(matrix_, cols_, stride_, 0, 0);
+}
+
+template <class T>
+S21MatrixIteratorT<const T> S21MatrixT<T>::end() const {
+  return S21MatrixIteratorT<const T>(matrix_, cols_, stride_, rows_, 0);
+}
+
+template <class T>
+S21SpanT<T> S21MatrixT<T>::RowSpan(int row) {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  MakeWritable();
+  exposed_ = true;
+  return S21SpanT<T>(&At(row, 0), cols_);
+}
+
+template <class T>
+S21SpanT<const T> S21MatrixT<T>::RowSpan(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  return S21SpanT<const T>(&At(row, 0), cols_);
+}
 
-int S21Matrix::GetCols() { return cols_; }
+template <class T>
+S21RowRangeT<T> S21MatrixT<T>::RowSpans() {
+  MakeWritable();
+  exposed_ = true;
+  return S21RowRangeT<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <class T>
+S21RowRangeT<const T> S21MatrixT<T>::RowSpans() const {
+  return S21RowRangeT<const T>(matrix_, rows_, cols_, stride_);
+}
 
-void S21Matrix::SetValue(int row, int col, double value) {
+template <class T>
+void S21MatrixT<T>::SetValue(int row, int col, T value) {
   if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
     throw std::out_of_range("Incorrect input, index is out of range.");
   } else {
-    matrix_[row][col] = value;
+    MakeWritable();
+    At(row, col) = value;
   }
 }
 
 // При увеличении размера - матрица дополняется нулевыми элементами, при
-// уменьшении - лишнее просто отбрасывается
-void S21Matrix::EditSize(int rows, int cols) {
+// уменьшении - лишнее просто отбрасывается. В пределах ёмкости буфер не
+// меняется: новые строки и новые столбцы обнуляются (хвосты строк могли
+// быть изменены через Data() или прийти из файла), при уменьшении числа
+// столбцов обнуляются их хвосты.
+// Иначе ёмкость растёт хотя бы вдвое по той размерности, которой не хватило,
+// поэтому рост матрицы по одной строке (столбцу) обходится в амортизированное
+// O(1) перевыделений на строку.
+template <class T>
+void S21MatrixT<T>::EditSize(int rows, int cols) {
+  S21_STATS_SCOPE(kEditSize, rows, cols, 0);
   if (rows == rows_ && cols == cols_) {
     // do nothing
   } else if (rows <= 0 || cols <= 0) {
     throw std::out_of_range("Incorrect input, index is out of range.");
   } else {
-    S21Matrix result(rows, cols);
-
-    if (rows <= rows_ && cols <= cols_) {
-      for (int y = 0; y < rows; y++)
-        for (int x = 0; x < cols; x++) result.SetValue(y, x, matrix_[y][x]);
-    } else if (rows > rows_ && cols > cols_) {
-      for (int y = 0; y < rows_; y++)
-        for (int x = 0; x < cols_; x++) result.SetValue(y, x, matrix_[y][x]);
-    } else if (rows <= rows_ && cols > cols_) {
-      for (int y = 0; y < rows; y++)
-        for (int x = 0; x < cols_; x++) result.SetValue(y, x, matrix_[y][x]);
-    } else if (rows > rows_ && cols <= cols_) {
-      for (int y = 0; y < rows_; y++)
-        for (int x = 0; x < cols; x++) result.SetValue(y, x, matrix_[y][x]);
+    MakeWritable();
+    bool reallocated = rows > capacity_rows_ || cols > stride_;
+    if (reallocated) {
+      int capacity_rows = capacity_rows_;
+      if (rows > capacity_rows)
+        capacity_rows = std::max(rows, 2 * capacity_rows);
+      int stride = stride_;
+      if (cols > stride) stride = PaddedStride(std::max(cols, 2 * stride));
+      Reallocate(capacity_rows, stride);
     }
 
-    Free();
-    *this = std::move(result);
+    int live_rows = std::min(rows, rows_);
+    if (cols < cols_) {
+      for (int y = 0; y < live_rows; y++)
+        std::memset(&At(y, cols), 0, (cols_ - cols) * sizeof(T));
+    } else if (cols > cols_ && !reallocated) {
+      // Reallocate уже обнулил хвосты строк
+      for (int y = 0; y < live_rows; y++)
+        std::memset(&At(y, cols_), 0, (cols - cols_) * sizeof(T));
+    }
+    if (rows > rows_) {
+      std::memset(&At(rows_, 0), 0,
+                  (std::size_t)(rows - rows_) * stride_ * sizeof(T));
+    }
+    rows_ = rows;
+    cols_ = cols;
   }
 }
 
-S21Matrix S21Matrix::SetCols(int cols) {
-  S21Matrix temp(rows_, cols);
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::SetCols(int cols) {
+  EditSize(rows_, cols);
+  return *this;
+}
+
+template <class T>
+S21MatrixT<T> &S21MatrixT<T>::SetRows(int rows) {
+  EditSize(rows, cols_);
+  return *this;
+}
+
+// Размер матрицы не меняется; буфер перевыделяется, только если его ёмкости
+// не хватает
+template <class T>
+void S21MatrixT<T>::Reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  int capacity_rows = std::max(rows, capacity_rows_);
+  int stride = std::max(PaddedStride(cols), stride_);
+  if (capacity_rows != capacity_rows_ || stride != stride_)
+    Reallocate(capacity_rows, stride);
+}
+
+template <class T>
+void S21MatrixT<T>::ShrinkToFit() {
+  if (capacity_rows_ != rows_ || stride_ != PaddedStride(cols_))
+    Reallocate(rows_, PaddedStride(cols_));
+}
+
+template <class T>
+int S21MatrixT<T>::RowCapacity() const { return capacity_rows_; }
+
+template <class T>
+int S21MatrixT<T>::ColCapacity() const { return stride_; }
+
+// СВЁРТКИ
+
+template <class T>
+T S21MatrixT<T>::Sum() const {
+  return Reduce(0, [](T x, T y) { return x + y; });
+}
+
+template <class T>
+T S21MatrixT<T>::Min() const {
+  if (rows_ == 0 || cols_ == 0) {
+    throw std::out_of_range("Incorrect input: the matrix is empty.");
+  }
+  return Reduce(At(0, 0), [](T x, T y) { return y < x ? y : x; });
+}
+
+template <class T>
+T S21MatrixT<T>::Max() const {
+  if (rows_ == 0 || cols_ == 0) {
+    throw std::out_of_range("Incorrect input: the matrix is empty.");
+  }
+  return Reduce(At(0, 0), [](T x, T y) { return y > x ? y : x; });
+}
+
+template <class T>
+T S21MatrixT<T>::NormFrobenius() const {
+  return std::sqrt(MapReduce(
+      0, [](T x) { return x * x; }, [](T x, T y) { return x + y; }));
+}
+
+template <class T>
+T S21MatrixT<T>::NormMax() const {
+  return MapReduce(
+      0, [](T x) { return std::fabs(x); },
+      [](T x, T y) { return y > x ? y : x; });
+}
+
+// Суммы модулей по столбцам копятся построчно: внутренний цикл идёт по
+// непрерывной строке и векторизуется
+template <class T>
+T S21MatrixT<T>::Norm1() const {
+  S21_STATS_SCOPE(kReduce, rows_, cols_, (double)rows_ * cols_);
+  std::vector<T> sums(cols_);
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < ((cols_ < cols) ? cols_ : cols); j++) {
-      temp.matrix_[i][j] = matrix_[i][j];
-    }
+    const T *row = &At(i, 0);
+    for (int j = 0; j < cols_; j++) sums[j] += std::fabs(row[j]);
   }
-  *this = std::move(temp);
-  return *this;
+  T norm = 0;
+  for (T sum : sums) norm = std::max(norm, sum);
+  return norm;
 }
 
-S21Matrix S21Matrix::SetRows(int rows) {
-  S21Matrix temp(rows, cols_);
-  for (int i = 0; i < ((rows_ < rows) ? rows_ : rows); i++) {
-    for (int j = 0; j < cols_; j++) {
-      temp.matrix_[i][j] = matrix_[i][j];
+template <class T>
+T S21MatrixT<T>::NormInf() const {
+  S21_STATS_SCOPE(kReduce, rows_, cols_, (double)rows_ * cols_);
+  if (rows_ == 0 || cols_ == 0) return 0;
+  std::vector<T> sums(rows_);
+  int block = RowBlock();
+  ForEachRowBlock([&](int b) {
+    for (int i = b * block; i < std::min(rows_, (b + 1) * block); i++) {
+      sums[i] = FoldRow(
+          &At(i, 0), cols_, [](T x) { return std::fabs(x); },
+          [](T x, T y) { return x + y; });
     }
-  }
-  *this = std::move(temp);
-  return *this;
+  });
+  T norm = 0;
+  for (T sum : sums) norm = std::max(norm, sum);
+  return norm;
 }
+
 // Вспомогательные
 
 // Заполняет матрицу нулями
-void S21Matrix::FillMatrixByZero() {
+template <class T>
+void S21MatrixT<T>::FillMatrixByZero() {
+  if (matrix_) S21GetKernels<T>().zero(matrix_, (std::size_t)rows_ * stride_);
+}
+
+// Вызывает fn(lo, hi) для диапазонов строк: большие матрицы делятся между
+// потоками пула, маленькие обрабатываются целиком в вызывающем потоке
+template <class T>
+void S21MatrixT<T>::ForEachRowRange(const std::function<void(int, int)> &fn) {
+  std::size_t elements = (std::size_t)rows_ * stride_;
+  if (elements < kParallelElements || S21GetNumThreads() == 1) {
+    fn(0, rows_);
+  } else {
+    int grain = (int)(kParallelGrain / stride_);
+    S21ThreadPool::Instance().ParallelFor(0, rows_, grain < 1 ? 1 : grain, fn);
+  }
+}
+
+// Маленькая матрица - один блок; у большой блок занимает около
+// kParallelGrain элементов
+template <class T>
+int S21MatrixT<T>::RowBlock() const {
+  std::size_t elements = (std::size_t)rows_ * stride_;
+  if (elements < kParallelElements) return std::max(rows_, 1);
+  return std::max((int)(kParallelGrain / stride_), 1);
+}
+
+template <class T>
+void S21MatrixT<T>::ForEachRowBlock(const std::function<void(int)> &fn) const {
+  int block = RowBlock(), blocks = (rows_ + block - 1) / block;
+  auto range = [&](int lo, int hi) {
+    for (int b = lo; b < hi; b++) fn(b);
+  };
+  if (blocks <= 1 || S21GetNumThreads() == 1) {
+    range(0, blocks);
+  } else {
+    S21ThreadPool::Instance().ParallelFor(0, blocks, 1, range);
+  }
+}
+
+// Обнуляет выравнивающие хвосты строк, которые не входят в матрицу
+template <class T>
+void S21MatrixT<T>::ZeroPadding() {
+  if (stride_ == cols_) return;
   for (int y = 0; y < rows_; y++)
-    for (int x = 0; x < cols_; x++) matrix_[y][x] = (double)0;
+    std::memset(&At(y, cols_), 0, (stride_ - cols_) * sizeof(T));
+}
+
+// Обменивает содержимое двух матриц без копирования данных
+template <class T>
+void S21MatrixT<T>::Swap(S21MatrixT &other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(capacity_rows_, other.capacity_rows_);
+  std::swap(matrix_, other.matrix_);
+  std::swap(allocator_, other.allocator_);
+  std::swap(cache_, other.cache_);
+  std::swap(exposed_, other.exposed_);
+}
+
+template <class T>
+bool S21MatrixT<T>::Writable() const {
+  return !allocator_ || allocator_->Writable();
+}
+
+// Номер версии не переходит к другой матрице ни при обмене, ни при переносе:
+// он только растёт
+template <class T>
+void S21MatrixT<T>::Invalidate() {
+  version_++;
+  cache_ = Cache();
+}
+
+// Матрица, загруженная из файла только для чтения, перед первой записью
+// переезжает в обычный буфер; отображение файла при этом освобождается
+template <class T>
+void S21MatrixT<T>::MakeWritable() {
+  Invalidate();
+  if (!Writable()) {
+    // Хвосты строк отображённого файла могут быть ненулевыми
+    S21MatrixT copy(*this);
+    copy.ZeroPadding();
+    Swap(copy);
+  }
 }
 
 // Заполняет матрицу значениями от 0 до (rows_ * cols_ - 1)
-void S21Matrix::FillMatrix() {
+template <class T>
+void S21MatrixT<T>::FillMatrix() {
+  MakeWritable();
   int k = 0;
   for (int y = 0; y < rows_; y++)
-    for (int x = 0; x < cols_; x++) matrix_[y][x] = (double)k++;
+    for (int x = 0; x < cols_; x++) At(y, x) = (T)k++;
 }
 
 // Заполняет матрицу случайными значениями
-void S21Matrix::FillMatrixRandom() {
+template <class T>
+void S21MatrixT<T>::FillMatrixRandom() {
+  MakeWritable();
   for (int y = 0; y < rows_; y++)
-    for (int x = 0; x < cols_; x++) matrix_[y][x] = (double)(std::rand() % 100);
+    for (int x = 0; x < cols_; x++) At(y, x) = (T)(std::rand() % 100);
 }
 
 // Выводит матрицу в консоль
-void S21Matrix::PrintMatrix() {
+template <class T>
+void S21MatrixT<T>::PrintMatrix() {
   printf("matrix:\n");
   for (int y = 0; y < rows_; y++) {
     for (int x = 0; x < cols_; x++) {
-      printf("%5.0lf ", matrix_[y][x]);
+      printf("%5.0Lf ", (long double)At(y, x));
     }
     printf("\n");
   }
 }
 
-// Освобождает память, выделенную под матрицы
-void S21Matrix::Free() {
-  if (rows_ != 0 && cols_ != 0) {
-    if (matrix_) {
-      for (int i = 0; i < rows_; i++) {
-        if (matrix_[i]) delete matrix_[i];
-      }
-      delete matrix_;
-    }
+// Освобождает память, выделенную под матрицы, возвращая её распределителю
+template <class T>
+void S21MatrixT<T>::Free() {
+  if (matrix_) {
+    std::size_t bytes = (std::size_t)capacity_rows_ * stride_ * sizeof(T);
+    S21_STATS_DEALLOCATION(bytes);
+    allocator_->Deallocate(matrix_, bytes);
+    matrix_ = nullptr;
   }
+  allocator_ = nullptr;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
+  capacity_rows_ = 0;
+  cache_ = Cache();
+  exposed_ = false;
 }
 
-// Возвращает минор матрицы
-S21Matrix S21Matrix::GetMinor(int oy, int ox) {
-  S21Matrix result(rows_ - 1, cols_ - 1);
+// Выделяет один выровненный по kAlignment буфер rows x stride (без
+// инициализации) из текущего распределителя потока
+template <class T>
+void S21MatrixT<T>::Allocate(int rows, int cols) {
+  rows_ = rows;
+  cols_ = cols;
+  stride_ = PaddedStride(cols);
+  capacity_rows_ = rows;
+  matrix_ = nullptr;
+  allocator_ = nullptr;
+
+  std::size_t count = (std::size_t)rows_ * stride_;
+  if (count != 0) {
+    S21MatrixAllocator &allocator = S21CurrentAllocator();
+    matrix_ = static_cast<T *>(allocator.Allocate(count * sizeof(T)));
+    allocator_ = &allocator;
+    S21_STATS_ALLOCATION(count * sizeof(T));
+  }
+}
 
-  for (int y = 0; y < rows_; y++)
-    for (int x = 0; x < cols_; x++) {
-      if (y == oy || x == ox)
-        continue;
-      else if (y < oy && x < ox)
-        result.matrix_[y][x] = matrix_[y][x];
-      else if (y > oy && x < ox)
-        result.matrix_[y - 1][x] = matrix_[y][x];
-      else if (y < oy && x > ox)
-        result.matrix_[y][x - 1] = matrix_[y][x];
-      else if (y > oy && x > ox)
-        result.matrix_[y - 1][x - 1] = matrix_[y][x];
+// Новый буфер выделяется из текущего распределителя потока; строки
+// копируются по cols_ элементов, хвосты строк обнуляются. Если выделить
+// память не удалось, матрица остаётся прежней.
+template <class T>
+void S21MatrixT<T>::Reallocate(int capacity_rows, int stride) {
+  S21MatrixT old(std::move(*this));
+  try {
+    Allocate(capacity_rows, stride);
+  } catch (...) {
+    Swap(old);
+    throw;
+  }
+  rows_ = old.rows_;
+  cols_ = old.cols_;
+  // Содержимое матрицы не меняется, но в старый буфер могли писать снаружи
+  if (!old.exposed_) cache_ = std::move(old.cache_);
+  for (int y = 0; y < rows_; y++) {
+    std::memcpy(&At(y, 0), &old.At(y, 0), cols_ * sizeof(T));
+    std::memset(&At(y, cols_), 0, (stride_ - cols_) * sizeof(T));
+  }
+}
+
+// Шаг строки, округлённый вверх до целого числа векторных регистров
+template <class T>
+int S21MatrixT<T>::PaddedStride(int cols) {
+  return (cols + kStrideStep - 1) / kStrideStep * kStrideStep;
+}
+
+// Произведение матриц в новой матрице (размеры проверяет вызывающий).
+// Умножение на столбец и строки на матрицу идёт ядрами GEMV: GEMM пакует
+// панели, что для вектора не окупается.
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::Product(const S21MatrixT &other,
+                             S21MulPolicy policy) const {
+  S21_STATS_SCOPE(kMulMatrix, rows_, other.cols_,
+                  2.0 * rows_ * other.cols_ * cols_);
+  S21MatrixT result(rows_, other.cols_);
+  if (other.cols_ == 1) {
+    // Столбец other собирается в непрерывный вектор и обратно
+    std::vector<T> x(cols_), y(rows_);
+    for (int k = 0; k < cols_; k++) x[k] = other.At(k, 0);
+    S21Gemv(rows_, cols_, matrix_, stride_, x.data(), y.data());
+    for (int i = 0; i < rows_; i++) result.At(i, 0) = y[i];
+    return result;
+  }
+  if (rows_ == 1) {
+    S21GemvT(other.rows_, other.cols_, other.matrix_, other.stride_, matrix_,
+             result.matrix_);
+    return result;
+  }
+
+  if (policy == S21MulPolicy::kAuto) {
+    bool large = rows_ >= kS21StrassenMinSize &&
+                 cols_ >= kS21StrassenMinSize &&
+                 other.cols_ >= kS21StrassenMinSize;
+    policy = large ? S21MulPolicy::kStrassen : S21MulPolicy::kClassic;
+  }
+
+  if (policy == S21MulPolicy::kStrassen) {
+    S21StrassenGemm(rows_, other.cols_, cols_, matrix_, stride_,
+                    other.matrix_, other.stride_, result.matrix_,
+                    result.stride_);
+  } else {
+    S21Gemm(rows_, other.cols_, cols_, matrix_, stride_, other.matrix_,
+            other.stride_, result.matrix_, result.stride_);
+  }
+
+  return result;
+}
+
+template <class T>
+T *S21MatrixT<T>::WritableData() {
+  MakeWritable();
+  return matrix_;
+}
+
+template <class T>
+S21MatrixViewT<T> S21MatrixT<T>::WritableView() {
+  MakeWritable();
+  return S21MatrixViewT<T>(matrix_, rows_, cols_, stride_);
+}
+
+// Вызывается в начале каждого метода, читающего кэш: если буфер выдан
+// наружу, его могли изменить после прошлого вызова
+template <class T>
+void S21MatrixT<T>::DropExposedCache() {
+  if (exposed_) cache_ = Cache();
+}
+
+// Разложение считается при первом обращении и хранится до изменения матрицы
+template <class T>
+const S21LUT<T> &S21MatrixT<T>::Factorization() {
+  if (!cache_.lu) {
+    S21_STATS_FLOPS(2.0 / 3 * rows_ * rows_ * rows_);
+    cache_.lu = std::make_shared<const S21LUT<T>>(*this);
+  }
+  return *cache_.lu;
+}
+
+// Обратная матрица по разложению из кэша; для вырожденной матрицы бросает
+// исключение и ничего не запоминает
+template <class T>
+const S21MatrixT<T> &S21MatrixT<T>::CachedInverse() {
+  if (!cache_.inverse) {
+    const S21LUT<T> &lu = Factorization();
+    if (lu.Singular()) {
+      throw std::out_of_range(
+          "Incorrect input: you can't inverse matrix if it's determinant is "
+          "equal to zero.");
     }
+    S21_STATS_FLOPS(4.0 / 3 * rows_ * rows_ * rows_);
+    cache_.inverse = std::make_shared<const S21MatrixT>(lu.Inverse());
+  }
+  return *cache_.inverse;
+}
+
+// Матрица дополнений через определители миноров - запасной путь для
+// вырожденных матриц, где тождество adj(A) = det(A) * A^(-1) неприменимо.
+// Все миноры разлагаются в одном и том же буфере.
+template <class T>
+void S21MatrixT<T>::ComplementsByMinors(S21MatrixT &result) {
+  S21MatrixT minor(rows_ - 1, cols_ - 1);
+  S21MatrixViewT<const T> source = std::as_const(*this).View();
+
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) {
+      CopyMinor(source, i, j, minor.WritableView());
+      S21_STATS_FLOPS(2.0 / 3 * minor.rows_ * minor.rows_ * minor.rows_);
+      T minor_det =
+          LuDeterminant(minor.matrix_, minor.rows_, minor.stride_, nullptr);
+      result.At(i, j) = ((i + j) % 2) ? -minor_det : minor_det;
+    }
+}
+
+// Возвращает минор матрицы (без строки oy и столбца ox)
+template <class T>
+S21MatrixT<T> S21MatrixT<T>::GetMinor(int oy, int ox) {
+  if (oy < 0 || ox < 0 || oy >= rows_ || ox >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  S21_STATS_SCOPE(kGetMinor, rows_ - 1, cols_ - 1, 0);
+  S21MatrixT result(rows_ - 1, cols_ - 1);
+  CopyMinor(std::as_const(*this).View(), oy, ox, result.WritableView());
 
   return result;
 }
 
 // Копирует содержимое одной матрицы в другую
-void S21Matrix::CopyMatrix(const S21Matrix &other) {
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
-    std::memcpy(matrix_[i], other.matrix_[i], other.cols_ * sizeof(double));
+template <class T>
+void S21MatrixT<T>::CopyMatrix(const S21MatrixT &other) {
+  S21_STATS_SCOPE(kCopyMatrix, other.rows_, other.cols_, 0);
+  Allocate(other.rows_, other.cols_);
+  if (!matrix_) {
+    // пустая матрица
+  } else if (stride_ == other.stride_) {
+    std::memcpy(matrix_, other.matrix_,
+                (std::size_t)rows_ * stride_ * sizeof(T));
+  } else {
+    // У other зарезервированы лишние столбцы
+    for (int y = 0; y < rows_; y++)
+      std::memcpy(&At(y, 0), &other.At(y, 0), cols_ * sizeof(T));
+    ZeroPadding();
   }
-}
\ No newline at end of file
+  if (!other.exposed_) cache_ = other.cache_;
+}
+
+template class S21MatrixT<float>;
+template class S21MatrixT<double>;
+template class S21MatrixT<long double>;
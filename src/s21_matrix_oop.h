@@ -1,69 +1,273 @@
 #ifndef __S21MATRIX_H__
 #define __S21MATRIX_H__
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_iterator.h"
+#include "s21_matrix_stats.h"
+#include "s21_matrix_view.h"
+
+// Алгоритм умножения матриц: kAuto выбирает Штрассена-Винограда для
+// больших матриц (s21_matrix_gemm.h), kClassic и kStrassen задают его явно
+enum class S21MulPolicy { kAuto, kClassic, kStrassen };
+
+// Способ загрузки матрицы из файла (S21Matrix::Load)
+enum class S21LoadMode {
+  kCopy,  // Данные читаются в новый буфер
+  // Файл отображается в память только для чтения и служит буфером матрицы;
+  // при первом изменении матрица копируется в обычный буфер
+  kMapReadOnly,
+  // Файл отображается с копированием при записи: изменённые страницы
+  // становятся личными, а файл не меняется
+  kMapPrivate,
+};
+
+template <class T>
+class S21LUT;  // s21_matrix_lu.h
+class S21SparseMatrix;  // s21_matrix_sparse.h
+class S21MatrixBatch;   // s21_matrix_batch.h
+template <int R, int C>
+class S21FixedMatrix;  // s21_matrix_fixed.h
+
+// Матрица с элементами типа T: float, double или long double. Методы
+// определены в s21_matrix_oop.cc и явно инстанцированы для этих трёх
+// типов; у каждого типа свои ядра (s21_matrix_kernels.h) и GEMM.
+// Save и Load - в s21_matrix_io.cc. S21Matrix - матрица double.
+template <class T>
+class S21MatrixT {
+  static_assert(std::is_floating_point<T>::value,
+                "S21MatrixT supports float, double and long double");
+  template <class U>
+  friend class S21MatrixT;
+  // Пишут в буфер новых матриц через WritableData()
+  friend class S21LUT<T>;
+  friend class S21SparseMatrix;
+  friend S21MatrixT<double> operator*(const S21MatrixT<double> &dense,
+                                      const S21SparseMatrix &sparse);
+  friend class S21MatrixBatch;
+  template <int R, int C>
+  friend class S21FixedMatrix;
 
-class S21Matrix {
  private:
+  // Выравнивание буфера в байтах и шаг строки в элементах (ширина SIMD)
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr int kStrideStep = kAlignment / sizeof(T);
+  // Поэлементные операции над матрицами меньше kParallelElements элементов
+  // не делятся между потоками; каждый поток получает не меньше kParallelGrain
+  static constexpr std::size_t kParallelElements = 1 << 16;
+  static constexpr std::size_t kParallelGrain = 1 << 14;
+  // Сторона плитки транспонирования: исходная и итоговая плитки вместе
+  // занимают 16 КБ и помещаются в L1
+  static constexpr int kTransposeTile = 32;
+  // Сторона блока, который TransposeInPlace переставляет через стек
+  static constexpr int kTransposeBlock = 8;
+
   // Атрибуты
   int rows_, cols_;
-  double **matrix_;
+  // Расстояние между началами соседних строк в элементах. Хвосты строк за
+  // cols_ - нули: методы пишут только в cols_ элементов строки, поэтому
+  // хвосты не зависят от значений матрицы (например, Inf или NaN)
+  int stride_;
+  int capacity_rows_;  // Число строк, под которое выделен буфер
+  T *matrix_;   // Единый выровненный буфер, строки подряд (row-major)
+  S21MatrixAllocator *allocator_;  // Распределитель, выделивший matrix_
+  // Результаты, вычисленные по разложению матрицы. Сбрасываются при любом
+  // изменении; копия матрицы разделяет их с оригиналом, пока сама не
+  // изменится.
+  struct Cache {
+    std::shared_ptr<const S21LUT<T>> lu;
+    std::shared_ptr<const S21MatrixT> inverse;
+    std::optional<T> determinant;
+  };
+  Cache cache_;
+  std::uint64_t version_ = 0;  // Растёт при каждом изменении матрицы
+  // Буфер выдан наружу для записи (Data(), View(), begin(), RowSpan() без
+  // const): запись через него не видна матрице, поэтому кэш не хранится
+  // между вызовами. Сбрасывается, когда матрица получает новый буфер.
+  bool exposed_ = false;
 
  public:
+  using value_type = T;
+
   // Конструкторы
-  S21Matrix();  // Базовый конструктор, инициализирующий матрицу некоторой
-                // заранее заданной размерностью
-  S21Matrix(int rows, int cols);  // Параметризированный конструктор с
-                                  // количеством строк и столбцов
-  S21Matrix(const S21Matrix &other);  // Конструктор копирования
-  S21Matrix(S21Matrix &&other) noexcept;  // Конструктор переноса
-  ~S21Matrix();                           // Деструктор
+  S21MatrixT();  // Базовый конструктор, инициализирующий матрицу некоторой
+                 // заранее заданной размерностью
+  S21MatrixT(int rows, int cols);  // Параметризированный конструктор с
+                                   // количеством строк и столбцов
+  S21MatrixT(const S21MatrixT &other);  // Конструктор копирования
+  S21MatrixT(S21MatrixT &&other) noexcept;  // Конструктор переноса
+  template <class U>
+  explicit S21MatrixT(const S21MatrixT<U> &other);  // Копия с другим типом
+  template <class E>
+  S21MatrixT(const S21MatrixExpr<E> &expr);  // Вычисляет выражение за 1 проход
+  ~S21MatrixT();                             // Деструктор
 
   // Методы
   bool EqMatrix(
-      const S21Matrix &other);  // Проверяет матрицы на равенство между собой
+      const S21MatrixT &other);  // Проверяет матрицы на равенство между собой
   void SumMatrix(
-      const S21Matrix &other);  // Прибавляет вторую матрицу к текущей
-  void SubMatrix(const S21Matrix &other);  // Вычитает из текущей матрицы другую
-  void MulNumber(const double num);  // Умножает текущую матрицу на число
-  void MulMatrix(const S21Matrix &other);  // Умножает текущую матрицу на вторую
-  S21Matrix Transpose();  // Создает новую транспонированную матрицу из текущей
-                          // и возвращает ее
-  S21Matrix CalcComplements();  // Вычисляет матрицу алгебраических дополнений
-                                // текущей матрицы и возвращает ее
-  double Determinant();  // Вычисляет и возвращает определитель текущей матрицы
-  S21Matrix InverseMatrix();  // Вычисляет и возвращает обратную матрицу
+      const S21MatrixT &other);  // Прибавляет вторую матрицу к текущей
+  void SubMatrix(
+      const S21MatrixT &other);  // Вычитает из текущей матрицы другую
+  void MulNumber(const T num);   // Умножает текущую матрицу на число
+  // Умножает текущую матрицу на вторую
+  void MulMatrix(const S21MatrixT &other,
+                 S21MulPolicy policy = S21MulPolicy::kAuto);
+  // Умножение на вектор без промежуточных матриц (GEMV, s21_matrix_gemm.h):
+  // MulVector - y = A x, x из GetCols() элементов; VectorMul - y^T = x^T A,
+  // x из GetRows() элементов. Варианты с указателями пишут в y без выделения
+  // памяти. MulMatrix сам переходит на эти ядра, если второй сомножитель -
+  // столбец или текущая матрица - строка.
+  std::vector<T> MulVector(const std::vector<T> &x) const;
+  void MulVector(const T *x, T *y) const;
+  std::vector<T> VectorMul(const std::vector<T> &x) const;
+  void VectorMul(const T *x, T *y) const;
+  S21MatrixT Transpose();  // Создает новую транспонированную матрицу из
+                           // текущей и возвращает ее
+  void TransposeInPlace();  // Транспонирует квадратную матрицу без выделения
+                            // памяти
+  S21MatrixT CalcComplements();  // Вычисляет матрицу алгебраических
+                                 // дополнений текущей матрицы и возвращает ее
+  T Determinant();  // Вычисляет и возвращает определитель текущей матрицы
+  S21MatrixT InverseMatrix();  // Вычисляет и возвращает обратную матрицу
+  S21MatrixT GetMinor(int oy, int ox);  // Возвращает минор матрицы
+  // Решает систему A X = B для всех столбцов B сразу (A - текущая матрица).
+  // Разложение A запоминается, как и для Determinant, InverseMatrix и
+  // CalcComplements: пока матрица не меняется, повторные вызовы его не
+  // пересчитывают. Поэтому эти методы нельзя вызывать для одной матрицы из
+  // нескольких потоков одновременно.
+  S21MatrixT Solve(const S21MatrixT &other);
 
   // Перегрузка операторов
-  S21Matrix operator+(const S21Matrix &other);  // Сложение двух матриц
-  S21Matrix operator-(
-      const S21Matrix &other);  // Вычитание одной матрицы из другой
-  S21Matrix operator*(const S21Matrix &other);  // Умножение матриц
-  S21Matrix operator*(const double num);  // Умножение матрицы на число
+  // +, - и * на число возвращают ленивые выражения (s21_matrix_expr.h).
+  // Перегрузки для временных матриц (&&) пишут результат в их буфер.
+  S21MatrixSumExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>> operator+(
+      const S21MatrixT &other) const &;  // Сложение двух матриц
+  S21MatrixT operator+(S21MatrixT &&other) const &;
+  S21MatrixT operator+(const S21MatrixT &other) &&;
+  S21MatrixT operator+(S21MatrixT &&other) &&;
+  S21MatrixSubExpr<S21MatrixLeafT<T>, S21MatrixLeafT<T>> operator-(
+      const S21MatrixT &other) const &;  // Вычитание одной матрицы из другой
+  S21MatrixT operator-(S21MatrixT &&other) const &;
+  S21MatrixT operator-(const S21MatrixT &other) &&;
+  S21MatrixT operator-(S21MatrixT &&other) &&;
+  S21MatrixT operator*(const S21MatrixT &other) const &;  // Умножение матриц
+  S21MatrixT operator*(const S21MatrixT &other) &&;
+  S21MatrixScaleExpr<S21MatrixLeafT<T>> operator*(
+      const T num) const &;  // Умножение матрицы на число
+  S21MatrixT operator*(const T num) &&;
   bool operator==(
-      const S21Matrix &other);  // Проверка матриц на равенство (EqMatrix)
-  S21Matrix &operator=(
-      const S21Matrix &other);  // Присвоение матрице значений другой матрицы
-  S21Matrix &operator+=(
-      const S21Matrix &other);  // Присвоение сложения (SumMatrix)
-  S21Matrix &operator-=(
-      const S21Matrix &other);  // Присвоение разности (SubMatrix)
-  S21Matrix &operator*=(
-      const S21Matrix &other);  // Присвоение умножения (MulMatrix)
-  S21Matrix &operator*=(const double num);  // Присвоение умножения (MulNumber)
-  double operator()(
-      int i,
-      int j);  // Индексация по элементам матрицы (строка, колонка)
+      const S21MatrixT &other);  // Проверка матриц на равенство (EqMatrix)
+  S21MatrixT &operator=(
+      const S21MatrixT &other);  // Присвоение матрице значений другой матрицы
+  S21MatrixT &operator=(S21MatrixT &&other) noexcept;  // Присвоение переносом
+  S21MatrixT &operator+=(
+      const S21MatrixT &other);  // Присвоение сложения (SumMatrix)
+  S21MatrixT &operator-=(
+      const S21MatrixT &other);  // Присвоение разности (SubMatrix)
+  S21MatrixT &operator*=(
+      const S21MatrixT &other);  // Присвоение умножения (MulMatrix)
+  S21MatrixT &operator*=(const T num);  // Присвоение умножения (MulNumber)
+  template <class E>
+  S21MatrixT &operator=(const S21MatrixExpr<E> &expr);  // Присвоение выражения
+  template <class E>
+  S21MatrixT &operator+=(
+      const S21MatrixExpr<E> &expr);  // Прибавление выражения
+  template <class E>
+  S21MatrixT &operator-=(const S21MatrixExpr<E> &expr);  // Вычитание выражения
+  T operator()(int i,
+               int j);  // Индексация по элементам матрицы (строка, колонка)
 
   // Accessors и mutators
-  int GetRows();
-  int GetCols();
-  S21Matrix SetCols(int cols);
-  S21Matrix SetRows(int rows);
-  void SetValue(int row, int col, double value);
+  int GetRows() const;
+  int GetCols() const;
+  S21MatrixT &SetCols(int cols);
+  S21MatrixT &SetRows(int rows);
+  void SetValue(int row, int col, T value);
   void EditSize(int rows, int cols);
+  // Ёмкость буфера, как у std::vector, но по обеим размерностям: в пределах
+  // RowCapacity() x ColCapacity() размер меняется без выделения памяти
+  void Reserve(int rows, int cols);  // Ёмкость не меньше rows x cols
+  void ShrinkToFit();  // Ёмкость ровно под текущий размер
+  int RowCapacity() const;
+  int ColCapacity() const;  // Совпадает с Stride()
+  T *Data();  // Указатель на начало непрерывного буфера
+  const T *Data() const;
+  int Stride() const;  // Шаг строки в элементах (кратен kStrideStep)
+  S21MatrixLeafT<T> Leaf() const;  // Лист выражения над данными матрицы
+  // Представления матрицы и её блоков без копирования (s21_matrix_view.h).
+  // Представления для записи действительны до изменения размера матрицы;
+  // матрица, отображённая из файла только для чтения, перед их выдачей
+  // копируется в обычный буфер.
+  S21MatrixViewT<T> View();
+  S21MatrixViewT<const T> View() const;
+  S21MatrixViewT<T> Block(int row, int col, int rows, int cols);
+  S21MatrixViewT<const T> Block(int row, int col, int rows, int cols) const;
+  S21MatrixViewT<T> Row(int row);
+  S21MatrixViewT<const T> Row(int row) const;
+  S21MatrixViewT<T> Col(int col);
+  S21MatrixViewT<const T> Col(int col) const;
+  // Итераторы по элементам (построчно, без выравнивающих хвостов) и отрезки
+  // строк (s21_matrix_iterator.h). Варианты без const, как и Data(),
+  // копируют буфер только для чтения и считаются изменением матрицы.
+  S21MatrixIteratorT<T> begin();
+  S21MatrixIteratorT<T> end();
+  S21MatrixIteratorT<const T> begin() const;
+  S21MatrixIteratorT<const T> end() const;
+  S21SpanT<T> RowSpan(int row);
+  S21SpanT<const T> RowSpan(int row) const;
+  S21RowRangeT<T> RowSpans();
+  S21RowRangeT<const T> RowSpans() const;
+  // Распределитель буфера матрицы (nullptr, если буфера нет)
+  S21MatrixAllocator *Allocator() const;
+  // Номер версии: меняется при каждом изменении матрицы через её методы.
+  // Data(), View(), Block(), Row(), Col(), begin(), end() и RowSpan() без
+  // const считаются изменением в момент вызова; запись через полученные
+  // раньше указатели, представления и итераторы номер не меняет. Такие
+  // матрицы не хранят разложение между вызовами Determinant, InverseMatrix,
+  // CalcComplements и Solve, поэтому их результаты всегда актуальны.
+  std::uint64_t Version() const;
+
+  // Поэлементные операции. Строки обрабатываются циклами по непрерывным
+  // элементам, которые компилятор векторизует, если функция встраивается;
+  // большие матрицы делятся между потоками пула. Поэтому f и op
+  // вызываются из нескольких потоков и не должны иметь побочных эффектов.
+  template <class F>
+  S21MatrixT &Apply(F f);  // matrix(i, j) = f(matrix(i, j))
+  // matrix = f(a) и matrix = f(a, b) поэлементно; размер матрицы становится
+  // размером a. a и b могут совпадать с текущей матрицей.
+  template <class F>
+  S21MatrixT &Transform(const S21MatrixT &a, F f);
+  template <class F>
+  S21MatrixT &Transform(const S21MatrixT &a, const S21MatrixT &b, F f);
+  // Свёртка всех элементов с начальным значением init. Как и у
+  // std::reduce, op должна быть ассоциативной и коммутативной: элементы
+  // сворачиваются в восемь независимых цепочек и по блокам строк. Порядок
+  // зависит только от размеров матрицы, а не от числа потоков.
+  template <class Op>
+  T Reduce(T init, Op op) const;
+  T Sum() const;
+  T Min() const;  // Для пустой матрицы Min и Max бросают std::out_of_range
+  T Max() const;
+  T NormFrobenius() const;  // Корень из суммы квадратов элементов
+  T NormMax() const;        // Наибольший модуль элемента
+  T Norm1() const;    // Наибольшая сумма модулей по столбцу
+  T NormInf() const;  // Наибольшая сумма модулей по строке
 
   // Вспомогательные
   void
@@ -71,13 +275,346 @@ class S21Matrix {
   void FillMatrixRandom();  // Заполняет матрицу случайными значениями
   void PrintMatrix();  // Выводит матрицу в консоль
 
+  // Ввод-вывод в двоичном формате (s21_matrix_io.h); тип элементов
+  // записывается в заголовок файла и проверяется при загрузке
+  void Save(const std::string &path) const;  // Пишет файл одним вызовом writev
+  static S21MatrixT Load(const std::string &path,
+                         S21LoadMode mode = S21LoadMode::kCopy);
+
  private:
   // Вспомогательные
   void FillMatrixByZero();  // Заполняет матрицу нулями
+  void Allocate(int rows, int cols);  // Выделяет выровненный буфер под матрицу
+  // Переносит матрицу в новый буфер ёмкостью capacity_rows x stride
+  void Reallocate(int capacity_rows, int stride);
   void Free();  // Освобождает память, выделенную под матрицы
-  S21Matrix GetMinor(int oy, int ox);  // Возвращает минор матрицы
+  T &At(int row, int col) {
+    return matrix_[(std::ptrdiff_t)row * stride_ + col];
+  }
+  const T &At(int row, int col) const {
+    return matrix_[(std::ptrdiff_t)row * stride_ + col];
+  }
+  static int PaddedStride(int cols);  // Шаг строки, выровненный до kStrideStep
+  void ForEachRowRange(const std::function<void(int, int)> &fn);
+  // Блоки по RowBlock() строк: размер блока зависит только от размеров
+  // матрицы. ForEachRowBlock вызывает fn(block) для каждого блока, у
+  // больших матриц - в потоках пула.
+  int RowBlock() const;
+  void ForEachRowBlock(const std::function<void(int)> &fn) const;
+  // Свёртка op значений map(row[j]) строки из n >= 1 элементов
+  template <class Map, class Op>
+  static T FoldRow(const T *row, int n, const Map &map, const Op &op);
+  template <class Map, class Op>
+  T MapReduce(T init, const Map &map, const Op &op) const;
+  void ZeroPadding();  // Обнуляет хвосты строк за cols_
+  void Swap(S21MatrixT &other) noexcept;  // Обменивает содержимое матриц
+  bool Writable() const;  // Можно ли менять буфер на месте
+  void Invalidate();  // Новая версия матрицы: сбрасывает кэш разложения
+  // Перед записью: сбрасывает кэш и копирует буфер только для чтения в обычный
+  void MakeWritable();
+  template <class Op, class E>
+  void EvalExpr(const E &expr);  // matrix(i, j) = Op(matrix(i, j), expr(i, j))
+  S21MatrixT Product(const S21MatrixT &other,
+                     S21MulPolicy policy = S21MulPolicy::kAuto)
+      const;  // Произведение матриц
+  // Data() и View() для записи изнутри библиотеки: указатель наружу не
+  // выдаётся, поэтому кэширование остаётся включённым
+  T *WritableData();
+  S21MatrixViewT<T> WritableView();
+  void DropExposedCache();  // Сбрасывает кэш, если буфер выдан наружу
+  const S21LUT<T> &Factorization();  // Разложение из кэша
+  const S21MatrixT &CachedInverse();  // Обратная матрица из кэша
+  void ComplementsByMinors(S21MatrixT &result);  // Дополнения через миноры
   void CopyMatrix(
-      const S21Matrix &other);  // Копирует содержимое одной матрицы в другую
+      const S21MatrixT &other);  // Копирует содержимое одной матрицы в другую
 };
 
-#endif
\ No newline at end of file
+using S21Matrix = S21MatrixT<double>;
+
+extern template class S21MatrixT<float>;
+extern template class S21MatrixT<double>;
+extern template class S21MatrixT<long double>;
+
+// ВЫРАЖЕНИЯ
+
+// Каждый элемент приводится к T; выравнивающие хвосты строк - нули
+template <class T>
+template <class U>
+S21MatrixT<T>::S21MatrixT(const S21MatrixT<U> &other)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_rows_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  S21_STATS_SCOPE(kCopyMatrix, other.rows_, other.cols_, 0);
+  Allocate(other.rows_, other.cols_);
+  ZeroPadding();
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) At(i, j) = (T)other.At(i, j);
+}
+
+template <class T>
+template <class E>
+S21MatrixT<T>::S21MatrixT(const S21MatrixExpr<E> &expr)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_rows_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  Allocate(expr.GetRows(), expr.GetCols());
+  ZeroPadding();
+  EvalExpr<S21ExprAssign>(expr.Self());
+}
+
+// Поэлементная запись безопасна, даже если выражение читает эту же матрицу:
+// элемент (i, j) зависит только от элементов (i, j) операндов
+template <class T>
+template <class E>
+S21MatrixT<T> &S21MatrixT<T>::operator=(const S21MatrixExpr<E> &expr) {
+  Invalidate();
+  if (rows_ == expr.GetRows() && cols_ == expr.GetCols()) {
+    EvalExpr<S21ExprAssign>(expr.Self());
+  } else {
+    S21MatrixT result(expr);
+    Swap(result);
+  }
+
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21MatrixT<T> &S21MatrixT<T>::operator+=(const S21MatrixExpr<E> &expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input: matriсes should have the same "
+        "size if you want to sum them.");
+  }
+  EvalExpr<S21ExprPlus>(expr.Self());
+
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21MatrixT<T> &S21MatrixT<T>::operator-=(const S21MatrixExpr<E> &expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input: matriсes should have the same "
+        "size if you want to sum them.");
+  }
+  EvalExpr<S21ExprMinus>(expr.Self());
+
+  return *this;
+}
+
+// Один проход по строкам: внутренний цикл по j векторизуется компилятором
+template <class T>
+template <class Op, class E>
+void S21MatrixT<T>::EvalExpr(const E &expr) {
+  static_assert(std::is_same<typename E::value_type, T>::value,
+                "Expression should have the same element type as the matrix");
+  Invalidate();
+  if (!Writable()) {
+    // Выражение может читать текущий буфер, поэтому он освобождается только
+    // после вычисления
+    S21MatrixT copy(*this);
+    copy.ZeroPadding();
+    copy.EvalExpr<Op>(expr);
+    Swap(copy);
+    return;
+  }
+
+  S21_STATS_SCOPE(kExpression, rows_, cols_, (double)rows_ * cols_);
+  ForEachRowRange([&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+      T *row = matrix_ + (std::ptrdiff_t)i * stride_;
+      for (int j = 0; j < cols_; j++)
+        row[j] = Op::Apply(row[j], expr.Eval(i, j));
+    }
+  });
+}
+
+template <class L, class R>
+S21MatrixSumExpr<L, R> operator+(const S21MatrixExpr<L> &left,
+                                 const S21MatrixExpr<R> &right) {
+  return S21MatrixSumExpr<L, R>(left.Self(), right.Self());
+}
+
+template <class T, class R>
+S21MatrixSumExpr<S21MatrixLeafT<T>, R> operator+(
+    const S21MatrixT<T> &left, const S21MatrixExpr<R> &right) {
+  return S21MatrixSumExpr<S21MatrixLeafT<T>, R>(left.Leaf(), right.Self());
+}
+
+template <class L, class T>
+S21MatrixSumExpr<L, S21MatrixLeafT<T>> operator+(
+    const S21MatrixExpr<L> &left, const S21MatrixT<T> &right) {
+  return S21MatrixSumExpr<L, S21MatrixLeafT<T>>(left.Self(), right.Leaf());
+}
+
+template <class L, class R>
+S21MatrixSubExpr<L, R> operator-(const S21MatrixExpr<L> &left,
+                                 const S21MatrixExpr<R> &right) {
+  return S21MatrixSubExpr<L, R>(left.Self(), right.Self());
+}
+
+template <class T, class R>
+S21MatrixSubExpr<S21MatrixLeafT<T>, R> operator-(
+    const S21MatrixT<T> &left, const S21MatrixExpr<R> &right) {
+  return S21MatrixSubExpr<S21MatrixLeafT<T>, R>(left.Leaf(), right.Self());
+}
+
+template <class L, class T>
+S21MatrixSubExpr<L, S21MatrixLeafT<T>> operator-(
+    const S21MatrixExpr<L> &left, const S21MatrixT<T> &right) {
+  return S21MatrixSubExpr<L, S21MatrixLeafT<T>>(left.Self(), right.Leaf());
+}
+
+// Выражение и временная матрица: результат пишется в буфер временной
+template <class T, class R>
+S21MatrixT<T> operator+(S21MatrixT<T> &&left, const S21MatrixExpr<R> &right) {
+  left += right;
+  return std::move(left);
+}
+
+template <class L, class T>
+S21MatrixT<T> operator+(const S21MatrixExpr<L> &left, S21MatrixT<T> &&right) {
+  right += left;
+  return std::move(right);
+}
+
+template <class T, class R>
+S21MatrixT<T> operator-(S21MatrixT<T> &&left, const S21MatrixExpr<R> &right) {
+  left -= right;
+  return std::move(left);
+}
+
+template <class L, class T>
+S21MatrixT<T> operator-(const S21MatrixExpr<L> &left, S21MatrixT<T> &&right) {
+  right = left - right;
+  return std::move(right);
+}
+
+template <class E>
+S21MatrixScaleExpr<E> operator*(const S21MatrixExpr<E> &expr,
+                                const typename E::value_type num) {
+  return S21MatrixScaleExpr<E>(expr.Self(), num);
+}
+
+// Умножение матриц не поэлементное: выражение сначала вычисляется
+template <class E, class T>
+S21MatrixT<T> operator*(const S21MatrixExpr<E> &left,
+                        const S21MatrixT<T> &right) {
+  S21MatrixT<T> result(left);
+  result.MulMatrix(right);
+  return result;
+}
+
+template <class L, class R>
+S21MatrixT<typename L::value_type> operator*(const S21MatrixExpr<L> &left,
+                                             const S21MatrixExpr<R> &right) {
+  S21MatrixT<typename L::value_type> result(left);
+  result.MulMatrix(S21MatrixT<typename R::value_type>(right));
+  return result;
+}
+
+// ПОЭЛЕМЕНТНЫЕ ОПЕРАЦИИ
+
+template <class T>
+template <class F>
+S21MatrixT<T> &S21MatrixT<T>::Apply(F f) {
+  MakeWritable();
+  S21_STATS_SCOPE(kApply, rows_, cols_, (double)rows_ * cols_);
+  ForEachRowRange([&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+      T *row = matrix_ + (std::ptrdiff_t)i * stride_;
+      for (int j = 0; j < cols_; j++) row[j] = f(row[j]);
+    }
+  });
+
+  return *this;
+}
+
+template <class T>
+template <class F>
+S21MatrixT<T> &S21MatrixT<T>::Transform(const S21MatrixT &a, F f) {
+  return Transform(a, a, [&f](T x, T) { return f(x); });
+}
+
+template <class T>
+template <class F>
+S21MatrixT<T> &S21MatrixT<T>::Transform(const S21MatrixT &a,
+                                        const S21MatrixT &b, F f) {
+  if (a.rows_ != b.rows_ || a.cols_ != b.cols_) {
+    throw std::out_of_range(
+        "Incorrect input: matrices should have the same size if you want "
+        "to transform them.");
+  }
+  // a и b другие матрицы, иначе размер уже совпадает
+  if (rows_ != a.rows_ || cols_ != a.cols_) {
+    *this = S21MatrixT(a.rows_, a.cols_);
+  }
+  MakeWritable();
+  S21_STATS_SCOPE(kApply, rows_, cols_, (double)rows_ * cols_);
+  ForEachRowRange([&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+      T *row = matrix_ + (std::ptrdiff_t)i * stride_;
+      const T *row_a = a.matrix_ + (std::ptrdiff_t)i * a.stride_;
+      const T *row_b = b.matrix_ + (std::ptrdiff_t)i * b.stride_;
+      for (int j = 0; j < cols_; j++) row[j] = f(row_a[j], row_b[j]);
+    }
+  });
+
+  return *this;
+}
+
+template <class T>
+template <class Op>
+T S21MatrixT<T>::Reduce(T init, Op op) const {
+  return MapReduce(init, [](T x) { return x; }, op);
+}
+
+// Восемь независимых цепочек компилятор держит в одном векторном регистре
+template <class T>
+template <class Map, class Op>
+T S21MatrixT<T>::FoldRow(const T *row, int n, const Map &map, const Op &op) {
+  constexpr int kLanes = 8;
+  if (n < 2 * kLanes) {
+    T acc = map(row[0]);
+    for (int j = 1; j < n; j++) acc = op(acc, map(row[j]));
+    return acc;
+  }
+  T lanes[kLanes];
+  for (int l = 0; l < kLanes; l++) lanes[l] = map(row[l]);
+  int j = kLanes;
+  for (; j + kLanes <= n; j += kLanes)
+    for (int l = 0; l < kLanes; l++) lanes[l] = op(lanes[l], map(row[j + l]));
+  for (; j < n; j++) lanes[0] = op(lanes[0], map(row[j]));
+  T acc = lanes[0];
+  for (int l = 1; l < kLanes; l++) acc = op(acc, lanes[l]);
+  return acc;
+}
+
+// Каждый блок строк сворачивается отдельно, итоги блоков - по порядку
+template <class T>
+template <class Map, class Op>
+T S21MatrixT<T>::MapReduce(T init, const Map &map, const Op &op) const {
+  S21_STATS_SCOPE(kReduce, rows_, cols_, (double)rows_ * cols_);
+  if (rows_ == 0 || cols_ == 0) return init;
+  int block = RowBlock();
+  std::vector<T> partial((rows_ + block - 1) / block);
+  ForEachRowBlock([&](int b) {
+    int lo = b * block, hi = std::min(rows_, lo + block);
+    T acc = FoldRow(&At(lo, 0), cols_, map, op);
+    for (int i = lo + 1; i < hi; i++)
+      acc = op(acc, FoldRow(&At(i, 0), cols_, map, op));
+    partial[b] = acc;
+  });
+  for (T value : partial) init = op(init, value);
+  return init;
+}
+
+#endif
@@ -0,0 +1,698 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+
+// Замеры всех открытых методов и операторов S21Matrix (s21_matrix_oop.h) и
+// основных операций S21MatrixT<float> и S21MatrixT<long double>.
+//
+// Размеры - лестница степеней двойки от kMinSize до kMaxSize; операции, не
+// требующие квадратной матрицы, дополнительно меряются на высоких (n x n/4)
+// и широких (n/4 x n) матрицах. Аргументы замера - (строки, столбцы).
+// Время - настенное: большие операции выполняет пул потоков.
+
+namespace {
+
+constexpr int kMinSize = 2;
+constexpr int kMaxSize = 4096;
+
+// Квадратные, высокие и широкие матрицы
+void Shapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"rows", "cols"});
+  for (int n = kMinSize; n <= kMaxSize; n *= 2) {
+    b->Args({n, n});
+    if (n >= 8) {
+      b->Args({n, n / 4});
+      b->Args({n / 4, n});
+    }
+  }
+  b->UseRealTime();
+}
+
+// Только квадратные матрицы
+void Squares(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"rows", "cols"});
+  for (int n = kMinSize; n <= kMaxSize; n *= 2) b->Args({n, n});
+  b->UseRealTime();
+}
+
+// Квадратные матрицы для сравнения типов элементов: long double считается
+// без SIMD, поэтому лестница короче
+void TypeSquares(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"rows", "cols"});
+  for (int n = 16; n <= 256; n *= 4) b->Args({n, n});
+  b->UseRealTime();
+}
+
+S21Matrix Random(int rows, int cols) {
+  S21Matrix m(rows, cols);
+  m.FillMatrixRandom();
+  return m;
+}
+
+// Матрица с диагональным преобладанием: невырожденная, определитель около
+// единицы и не переполняется даже для 4096 x 4096
+S21Matrix WellConditioned(int n) {
+  S21Matrix m = Random(n, n);
+  m.MulNumber(1e-4 / n);
+  for (int i = 0; i < n; i++) m.SetValue(i, i, m(i, i) + 1);
+  return m;
+}
+
+// Обработанные элементы (для поэлементных операций)
+void SetElements(benchmark::State &state, double per_iteration) {
+  state.counters["elements"] = benchmark::Counter(
+      per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Операции с плавающей точкой (для умножения и разложений)
+void SetFlops(benchmark::State &state, double per_iteration) {
+  state.counters["flops"] = benchmark::Counter(
+      per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+int Rows(const benchmark::State &state) { return (int)state.range(0); }
+int Cols(const benchmark::State &state) { return (int)state.range(1); }
+
+}  // namespace
+
+// КОНСТРУКТОРЫ
+
+static void BM_DefaultConstructor(benchmark::State &state) {
+  for (auto _ : state) {
+    S21Matrix m;
+    benchmark::DoNotOptimize(m.Data());
+  }
+}
+BENCHMARK(BM_DefaultConstructor);
+
+static void BM_Constructor(benchmark::State &state) {
+  for (auto _ : state) {
+    S21Matrix m(Rows(state), Cols(state));
+    benchmark::DoNotOptimize(m.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_Constructor)->Apply(Shapes);
+
+static void BM_CopyConstructor(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix m(a);
+    benchmark::DoNotOptimize(m.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_CopyConstructor)->Apply(Shapes);
+
+static void BM_MoveConstructor(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix m(std::move(a));
+    benchmark::DoNotOptimize(m.Data());
+    a = std::move(m);
+  }
+}
+BENCHMARK(BM_MoveConstructor)->Apply(Shapes);
+
+// МЕТОДЫ
+
+static void BM_EqMatrix(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state)), b(a);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_EqMatrix)->Apply(Shapes);
+
+static void BM_SumMatrix(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_SumMatrix)->Apply(Shapes);
+
+static void BM_SubMatrix(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_SubMatrix)->Apply(Shapes);
+
+static void BM_MulNumber(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.MulNumber(1.0);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_MulNumber)->Apply(Shapes);
+
+// A (rows x cols) *= B (cols x cols): размер A не меняется между итерациями,
+// а усредняющая B не даёт значениям расти
+static void BM_MulMatrix(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols), b(cols, cols);
+  for (int i = 0; i < cols; i++)
+    for (int j = 0; j < cols; j++) b.SetValue(i, j, 1.0 / cols);
+  for (auto _ : state) {
+    a.MulMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 2.0 * rows * cols * cols);
+}
+BENCHMARK(BM_MulMatrix)->Apply(Shapes);
+
+// Матрица на столбец через MulMatrix: произведение идёт ядром GEMV
+static void BM_MulMatrixColumn(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state)), x = Random(Cols(state), 1);
+  for (auto _ : state) benchmark::DoNotOptimize((a * x).Data());
+  SetFlops(state, 2.0 * Rows(state) * Cols(state));
+}
+BENCHMARK(BM_MulMatrixColumn)->Apply(Shapes);
+
+static void BM_MulVector(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  std::vector<double> x(Cols(state), 1.0), y(Rows(state));
+  for (auto _ : state) {
+    a.MulVector(x.data(), y.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 2.0 * Rows(state) * Cols(state));
+}
+BENCHMARK(BM_MulVector)->Apply(Shapes);
+
+static void BM_VectorMul(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  std::vector<double> x(Rows(state), 1.0), y(Cols(state));
+  for (auto _ : state) {
+    a.VectorMul(x.data(), y.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 2.0 * Rows(state) * Cols(state));
+}
+BENCHMARK(BM_VectorMul)->Apply(Shapes);
+
+static void BM_Transpose(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Transpose().Data());
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_Transpose)->Apply(Shapes);
+
+static void BM_TransposeInPlace(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(Squares);
+
+static void BM_CalcComplements(benchmark::State &state) {
+  S21Matrix a = WellConditioned(Rows(state));
+  for (auto _ : state) {
+    a.SetValue(0, 0, a(0, 0));  // Сбрасывает запомненное разложение
+    benchmark::DoNotOptimize(a.CalcComplements().Data());
+  }
+  SetFlops(state, 2.0 * Rows(state) * Rows(state) * Rows(state));
+}
+BENCHMARK(BM_CalcComplements)->Apply(Squares);
+
+static void BM_Determinant(benchmark::State &state) {
+  S21Matrix a = WellConditioned(Rows(state));
+  for (auto _ : state) {
+    a.SetValue(0, 0, a(0, 0));  // Сбрасывает запомненное разложение
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  SetFlops(state, 2.0 / 3 * Rows(state) * Rows(state) * Rows(state));
+}
+BENCHMARK(BM_Determinant)->Apply(Squares);
+
+static void BM_InverseMatrix(benchmark::State &state) {
+  S21Matrix a = WellConditioned(Rows(state));
+  for (auto _ : state) {
+    a.SetValue(0, 0, a(0, 0));  // Сбрасывает запомненное разложение
+    benchmark::DoNotOptimize(a.InverseMatrix().Data());
+  }
+  SetFlops(state, 2.0 * Rows(state) * Rows(state) * Rows(state));
+}
+BENCHMARK(BM_InverseMatrix)->Apply(Squares);
+
+// Повторный определитель неизменной матрицы берётся из кэша
+static void BM_DeterminantCached(benchmark::State &state) {
+  S21Matrix a = WellConditioned(Rows(state));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+}
+BENCHMARK(BM_DeterminantCached)->Apply(Squares);
+
+// Система с одной правой частью: разложение и подстановка на каждой итерации
+static void BM_Solve(benchmark::State &state) {
+  S21Matrix a = WellConditioned(Rows(state)), b = Random(Rows(state), 1);
+  for (auto _ : state) {
+    a.SetValue(0, 0, a(0, 0));
+    benchmark::DoNotOptimize(a.Solve(b).Data());
+  }
+  SetFlops(state, 2.0 / 3 * Rows(state) * Rows(state) * Rows(state));
+}
+BENCHMARK(BM_Solve)->Apply(Squares);
+
+// Подстановка по сохранённому разложению S21LU для одной правой части
+static void BM_LuSolve(benchmark::State &state) {
+  S21LU lu(WellConditioned(Rows(state)));
+  S21Matrix b = Random(Rows(state), 1);
+  for (auto _ : state) benchmark::DoNotOptimize(lu.Solve(b).Data());
+  SetFlops(state, 2.0 * Rows(state) * Rows(state));
+}
+BENCHMARK(BM_LuSolve)->Apply(Squares);
+
+// Минор без центральной строки и столбца: четыре блока копируются по строкам
+static void BM_GetMinor(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  const int center = Rows(state) / 2;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a.GetMinor(center, center).Data());
+  SetElements(state, (double)(Rows(state) - 1) * (Cols(state) - 1));
+}
+BENCHMARK(BM_GetMinor)->Apply(Squares);
+
+// Сложение центральных блоков (половина каждой стороны) через представления
+static void BM_BlockSumMatrix(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols), b = Random(rows, cols);
+  S21MatrixView dst = a.Block(rows / 4, cols / 4, rows / 2, cols / 2);
+  S21MatrixView src = b.Block(rows / 4, cols / 4, rows / 2, cols / 2);
+  for (auto _ : state) {
+    dst.SumMatrix(src);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)(rows / 2) * (cols / 2));
+}
+BENCHMARK(BM_BlockSumMatrix)->Apply(Shapes);
+
+// ПЕРЕГРУЗКА ОПЕРАТОРОВ
+
+static void BM_OperatorSum(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix c = a + b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorSum)->Apply(Shapes);
+
+static void BM_OperatorSub(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix c = a - b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorSub)->Apply(Shapes);
+
+// Цепочка a + b * 2 - a вычисляется выражением за один проход
+static void BM_OperatorExpression(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix c = a + b * 2.0 - a;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorExpression)->Apply(Shapes);
+
+// A (rows x cols) * B (cols x rows): высокие матрицы дают большое
+// произведение с короткой суммой, широкие - маленькое с длинной
+static void BM_OperatorMulMatrix(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols), b = Random(cols, rows);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * rows * rows * cols);
+}
+BENCHMARK(BM_OperatorMulMatrix)->Apply(Shapes);
+
+static void BM_OperatorMulNumber(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    S21Matrix c = a * 2.0;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorMulNumber)->Apply(Shapes);
+
+static void BM_OperatorEq(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state)), b(a);
+  for (auto _ : state) benchmark::DoNotOptimize(a == b);
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorEq)->Apply(Shapes);
+
+static void BM_CopyAssignment(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state)), b(Rows(state), Cols(state));
+  for (auto _ : state) {
+    b = a;
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_CopyAssignment)->Apply(Shapes);
+
+static void BM_MoveAssignment(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state)), b;
+  for (auto _ : state) {
+    b = std::move(a);
+    a = std::move(b);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_MoveAssignment)->Apply(Shapes);
+
+static void BM_OperatorSumAssign(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a += b;
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorSumAssign)->Apply(Shapes);
+
+static void BM_OperatorSubAssign(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a -= b;
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorSubAssign)->Apply(Shapes);
+
+static void BM_OperatorMulAssignMatrix(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols), b(cols, cols);
+  for (int i = 0; i < cols; i++)
+    for (int j = 0; j < cols; j++) b.SetValue(i, j, 1.0 / cols);
+  for (auto _ : state) {
+    a *= b;
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 2.0 * rows * cols * cols);
+}
+BENCHMARK(BM_OperatorMulAssignMatrix)->Apply(Shapes);
+
+static void BM_OperatorMulAssignNumber(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a *= 1.0;
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_OperatorMulAssignNumber)->Apply(Shapes);
+
+// Обход всех элементов через operator() (с проверкой индексов)
+static void BM_OperatorIndex(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols);
+  for (auto _ : state) {
+    double sum = 0;
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++) sum += a(i, j);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElements(state, (double)rows * cols);
+}
+BENCHMARK(BM_OperatorIndex)->Apply(Shapes);
+
+// ACCESSORS И MUTATORS
+
+static void BM_GetRowsCols(benchmark::State &state) {
+  S21Matrix a(3, 5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.GetRows());
+    benchmark::DoNotOptimize(a.GetCols());
+  }
+}
+BENCHMARK(BM_GetRowsCols);
+
+// SetRows / SetCols / EditSize: поочерёдно на строку (столбец) больше и
+// обратно
+static void BM_SetRows(benchmark::State &state) {
+  const int rows = Rows(state);
+  S21Matrix a = Random(rows, Cols(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.SetRows(rows + 1).Data());
+    benchmark::DoNotOptimize(a.SetRows(rows).Data());
+  }
+  SetElements(state, 2.0 * rows * Cols(state));
+}
+BENCHMARK(BM_SetRows)->Apply(Shapes);
+
+static void BM_SetCols(benchmark::State &state) {
+  const int cols = Cols(state);
+  S21Matrix a = Random(Rows(state), cols);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.SetCols(cols + 1).Data());
+    benchmark::DoNotOptimize(a.SetCols(cols).Data());
+  }
+  SetElements(state, 2.0 * Rows(state) * cols);
+}
+BENCHMARK(BM_SetCols)->Apply(Shapes);
+
+static void BM_EditSize(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a = Random(rows, cols);
+  for (auto _ : state) {
+    a.EditSize(rows + 1, cols + 1);
+    a.EditSize(rows, cols);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, 2.0 * rows * cols);
+}
+BENCHMARK(BM_EditSize)->Apply(Shapes);
+
+// Матрица растёт с одной строки до rows по строке за раз, как накопитель
+static void BM_AppendRows(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  for (auto _ : state) {
+    S21Matrix a(1, cols);
+    for (int i = 2; i <= rows; i++) a.SetRows(i).SetValue(i - 1, 0, i);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, (double)rows * cols);
+}
+BENCHMARK(BM_AppendRows)->Apply(Shapes);
+
+static void BM_SetValue(benchmark::State &state) {
+  const int rows = Rows(state), cols = Cols(state);
+  S21Matrix a(rows, cols);
+  for (auto _ : state) {
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++) a.SetValue(i, j, i + j);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)rows * cols);
+}
+BENCHMARK(BM_SetValue)->Apply(Shapes);
+
+static void BM_DataAndStride(benchmark::State &state) {
+  S21Matrix a(3, 5);
+  const S21Matrix &c = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Data());
+    benchmark::DoNotOptimize(c.Data());
+    benchmark::DoNotOptimize(a.Stride());
+    benchmark::DoNotOptimize(a.Leaf());
+    benchmark::DoNotOptimize(a.Allocator());
+  }
+}
+BENCHMARK(BM_DataAndStride);
+
+// ВСПОМОГАТЕЛЬНЫЕ
+
+static void BM_FillMatrix(benchmark::State &state) {
+  S21Matrix a(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.FillMatrix();
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_FillMatrix)->Apply(Shapes);
+
+static void BM_FillMatrixRandom(benchmark::State &state) {
+  S21Matrix a(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.FillMatrixRandom();
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_FillMatrixRandom)->Apply(Shapes);
+
+// На время замера stdout направлен в /dev/null: меряется форматирование, а
+// не терминал
+static void BM_PrintMatrix(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  std::fflush(stdout);
+  int saved = dup(STDOUT_FILENO), null = open("/dev/null", O_WRONLY);
+  dup2(null, STDOUT_FILENO);
+  close(null);
+  for (auto _ : state) a.PrintMatrix();
+  std::fflush(stdout);
+  dup2(saved, STDOUT_FILENO);
+  close(saved);
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_PrintMatrix)->Apply(Shapes);
+
+// ПОЭЛЕМЕНТНЫЕ ОПЕРАЦИИ
+
+// Для сравнения: сумма циклом по operator() с проверкой индексов
+static void BM_SumLoop(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    double sum = 0;
+    for (int i = 0; i < a.GetRows(); i++)
+      for (int j = 0; j < a.GetCols(); j++) sum += a(i, j);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_SumLoop)->Apply(Shapes);
+
+static void BM_Sum(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Sum());
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_Sum)->Apply(Shapes);
+
+static void BM_NormFrobenius(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) benchmark::DoNotOptimize(a.NormFrobenius());
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_NormFrobenius)->Apply(Shapes);
+
+static void BM_Apply(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) {
+    a.Apply([](double x) { return x * 0.5 + 1; });
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_Apply)->Apply(Shapes);
+
+static void BM_Transform(benchmark::State &state) {
+  S21Matrix a = Random(Rows(state), Cols(state));
+  S21Matrix b = Random(Rows(state), Cols(state)), c(a.GetRows(), a.GetCols());
+  for (auto _ : state) {
+    c.Transform(a, b, [](double x, double y) { return x * y - 1; });
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK(BM_Transform)->Apply(Shapes);
+
+// ВВОД-ВЫВОД
+
+static void BM_Save(benchmark::State &state) {
+  const std::string path = "s21_matrix_bench.bin";
+  S21Matrix a = Random(Rows(state), Cols(state));
+  for (auto _ : state) a.Save(path);
+  std::remove(path.c_str());
+  state.SetBytesProcessed(state.iterations() * Rows(state) * a.Stride() *
+                          (int64_t)sizeof(double));
+}
+BENCHMARK(BM_Save)->Apply(Shapes);
+
+static void BM_Load(benchmark::State &state) {
+  const std::string path = "s21_matrix_bench.bin";
+  const S21LoadMode mode = (S21LoadMode)state.range(2);
+  S21Matrix a = Random(Rows(state), Cols(state));
+  a.Save(path);
+  for (auto _ : state) {
+    S21Matrix m = S21Matrix::Load(path, mode);
+    benchmark::DoNotOptimize(m.Data());
+  }
+  std::remove(path.c_str());
+  state.SetLabel(mode == S21LoadMode::kCopy ? "copy" : "map");
+}
+BENCHMARK(BM_Load)->Apply([](benchmark::internal::Benchmark *b) {
+  b->ArgNames({"rows", "cols", "mode"});
+  for (int n = kMinSize; n <= kMaxSize; n *= 2) {
+    b->Args({n, n, (int)S21LoadMode::kCopy});
+    b->Args({n, n, (int)S21LoadMode::kMapReadOnly});
+  }
+  b->UseRealTime();
+});
+
+// ТИПЫ ЭЛЕМЕНТОВ
+
+template <class T>
+static void BM_SumMatrixT(benchmark::State &state) {
+  S21MatrixT<T> a(Random(Rows(state), Cols(state)));
+  S21MatrixT<T> b(Random(Rows(state), Cols(state)));
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, (double)Rows(state) * Cols(state));
+}
+BENCHMARK_TEMPLATE(BM_SumMatrixT, float)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_SumMatrixT, double)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_SumMatrixT, long double)->Apply(TypeSquares);
+
+template <class T>
+static void BM_MulMatrixT(benchmark::State &state) {
+  S21MatrixT<T> a(Random(Rows(state), Cols(state)));
+  S21MatrixT<T> b(Random(Cols(state), Cols(state)));
+  for (auto _ : state) benchmark::DoNotOptimize((a * b).Data());
+  SetFlops(state, 2.0 * Rows(state) * Cols(state) * Cols(state));
+}
+BENCHMARK_TEMPLATE(BM_MulMatrixT, float)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_MulMatrixT, double)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_MulMatrixT, long double)->Apply(TypeSquares);
+
+template <class T>
+static void BM_InverseMatrixT(benchmark::State &state) {
+  S21MatrixT<T> a(WellConditioned(Rows(state)));
+  for (auto _ : state) {
+    a.SetValue(0, 0, a(0, 0));
+    benchmark::DoNotOptimize(a.InverseMatrix().Data());
+  }
+  SetFlops(state, 2.0 * Rows(state) * Rows(state) * Rows(state));
+}
+BENCHMARK_TEMPLATE(BM_InverseMatrixT, float)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_InverseMatrixT, double)->Apply(TypeSquares);
+BENCHMARK_TEMPLATE(BM_InverseMatrixT, long double)->Apply(TypeSquares);
+
+BENCHMARK_MAIN();
@@ -1,7 +1,31 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_fixed.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_lu.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_stats.h"
+#include "s21_matrix_stream.h"
+#include "s21_matrix_thread_pool.h"
 
 // КОНСТРУКТОРЫ
 
@@ -47,9 +71,14 @@ TEST(Constructors, Move) {
   EXPECT_EQ(M1.GetCols(), 0);
 }
 
+// Буфер забирает M2 и освобождает его деструктор; читать поля после
+// деструктора нельзя, поэтому проверяется оставшаяся пустой M1
 TEST(Constructors, Destructor) {
   S21Matrix M1;
-  M1.~S21Matrix();
+  {
+    S21Matrix M2(std::move(M1));
+    EXPECT_EQ(M2.GetRows(), 3);
+  }
 
   EXPECT_EQ(M1.GetRows(), 0);
   EXPECT_EQ(M1.GetCols(), 0);
@@ -147,6 +176,24 @@ TEST(Methods, MulMatrix) {
   EXPECT_TRUE(exception);
 }
 
+TEST(Methods, MulMatrixBlocked) {
+  // Размеры не кратны блокам микроядра и больше блока по k
+  const int m = 67, k = 301, n = 45;
+  S21Matrix M1(m, k), M2(k, n);
+  M1.FillMatrixRandom();
+  M2.FillMatrixRandom();
+  S21Matrix M3 = M1 * M2;
+
+  ASSERT_EQ(M3.GetRows(), m);
+  ASSERT_EQ(M3.GetCols(), n);
+  for (int y = 0; y < m; y++)
+    for (int x = 0; x < n; x++) {
+      double expected = 0;
+      for (int i = 0; i < k; i++) expected += M1(y, i) * M2(i, x);
+      EXPECT_DOUBLE_EQ(M3(y, x), expected);
+    }
+}
+
 TEST(Methods, Transpose) {
   S21Matrix M1(1, 3);
   M1.FillMatrix();
@@ -157,6 +204,34 @@ TEST(Methods, Transpose) {
   EXPECT_EQ(M2(2, 0), 2);
 }
 
+TEST(Methods, TransposeLarge) {
+  S21Matrix M1(75, 133);  // Края не кратны ни плитке, ни ширине вектора
+  M1.FillMatrixRandom();
+  S21Matrix M2 = M1.Transpose();
+
+  ASSERT_EQ(M2.GetRows(), 133);
+  ASSERT_EQ(M2.GetCols(), 75);
+  for (int y = 0; y < 75; y++)
+    for (int x = 0; x < 133; x++) EXPECT_EQ(M2(x, y), M1(y, x));
+  EXPECT_TRUE(M2.Transpose() == M1);
+}
+
+TEST(Methods, TransposeInPlace) {
+  for (int n : {1, 7, 8, 19, 64}) {
+    S21Matrix M1(n, n);
+    M1.FillMatrix();
+    S21Matrix Expected = M1.Transpose();
+    const double *data = M1.Data();
+
+    M1.TransposeInPlace();
+    EXPECT_TRUE(M1 == Expected);
+    EXPECT_EQ(M1.Data(), data);
+  }
+
+  S21Matrix M2(2, 3);
+  EXPECT_THROW(M2.TransposeInPlace(), std::out_of_range);
+}
+
 TEST(Methods, CalcComplements) {
   S21Matrix M1;
   M1.SetValue(0, 0, 1);
@@ -176,18 +251,17 @@ TEST(Methods, CalcComplements) {
     for (int x = 0; x < M1.GetCols(); x++, n++)
       EXPECT_EQ(M2(y, x), complement[n]);
 
-  // Определитель равен нулю
-  bool exception = false;
-  try {
-    S21Matrix M1;
-    M1.FillMatrix();
-    M1.CalcComplements();
-  } catch (const std::out_of_range &e) {
-    exception = true;
-  }
-  EXPECT_TRUE(exception);
+  // Определитель равен нулю - дополнения всё равно существуют
+  S21Matrix M3;
+  M3.FillMatrix();
+  double singular[9] = {-3, 6, -3, 6, -12, 6, -3, 6, -3};
+  S21Matrix M4 = M3.CalcComplements();
+  for (int y = 0, n = 0; y < M3.GetRows(); y++)
+    for (int x = 0; x < M3.GetCols(); x++, n++)
+      EXPECT_EQ(M4(y, x), singular[n]);
 
   // Неквадратная матрица
+  bool exception = false;
   try {
     S21Matrix M1(4, 5);
     M1.FillMatrix();
@@ -198,6 +272,40 @@ TEST(Methods, CalcComplements) {
   EXPECT_TRUE(exception);
 }
 
+TEST(Methods, CalcComplementsLarge) {
+  // Дополнения через det * A^(-T) должны удовлетворять определению:
+  // A * C^T = det(A) * E
+  const int n = 6;
+  S21Matrix M1(n, n);
+  M1.FillMatrixRandom();
+  for (int i = 0; i < n; i++) M1.SetValue(i, i, M1(i, i) + 100);
+  double det = M1.Determinant();
+  S21Matrix Adj = M1.CalcComplements().Transpose();
+  S21Matrix Product = M1 * Adj;
+  for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++)
+      EXPECT_NEAR(Product(y, x), (y == x) ? det : 0, std::fabs(det) * 1e-12);
+
+  // Вырожденная матрица (нулевая строка) идёт через миноры: ненулевые
+  // дополнения есть только у элементов этой строки
+  for (int x = 0; x < n; x++) M1.SetValue(1, x, 0);
+  S21Matrix C = M1.CalcComplements();
+  S21Matrix Minor(n - 1, n - 1);
+  for (int y = 0, my = 0; y < n; y++) {
+    if (y == 1) continue;
+    for (int x = 1; x < n; x++) Minor.SetValue(my, x - 1, M1(y, x));
+    my++;
+  }
+  double minor_det = Minor.Determinant();
+  EXPECT_NEAR(C(1, 0), -minor_det, std::fabs(minor_det) * 1e-12);
+  for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++) {
+      if (y != 1) {
+        EXPECT_EQ(C(y, x), 0);
+      }
+    }
+}
+
 TEST(Methods, Determinant) {
   double det;
   S21Matrix M1(3, 3);
@@ -224,6 +332,26 @@ TEST(Methods, Determinant) {
   EXPECT_TRUE(exception);
 }
 
+TEST(Methods, DeterminantLarge) {
+  // 2 на диагонали, 1 вне её: собственные числа n + 1 и (n - 1) единиц
+  const int n = 20;
+  S21Matrix M1(n, n);
+  for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++) M1.SetValue(y, x, (y == x) ? 2 : 1);
+  EXPECT_NEAR(M1.Determinant(), n + 1, 1e-9);
+
+  // Нулевой элемент на диагонали требует перестановки строк
+  S21Matrix M2(4, 4);
+  double m2[16] = {0, 2, 1, 3, 1, 0, 0, 2, 4, 1, 2, 0, 3, 3, 1, 1};
+  for (int y = 0, k = 0; y < 4; y++)
+    for (int x = 0; x < 4; x++, k++) M2.SetValue(y, x, m2[k]);
+  EXPECT_NEAR(M2.Determinant(), 38, 1e-9);
+
+  // Нулевая строка даёт нулевой определитель
+  for (int x = 0; x < 4; x++) M2.SetValue(2, x, 0);
+  EXPECT_EQ(M2.Determinant(), 0);
+}
+
 TEST(Methods, InverseMatrix) {
   S21Matrix M1(2, 2);
   M1.SetValue(0, 0, 0);
@@ -241,21 +369,32 @@ TEST(Methods, InverseMatrix) {
   try {
     S21Matrix M1;
     M1.FillMatrix();
-    M1.CalcComplements();
+    M1.InverseMatrix();
   } catch (const std::out_of_range &e) {
     exception = true;
   }
   EXPECT_TRUE(exception);
 
   // Неквадратная матрица
+  exception = false;
   try {
     S21Matrix M1(4, 5);
     M1.FillMatrix();
-    M1.CalcComplements();
+    M1.InverseMatrix();
   } catch (const std::out_of_range &e) {
     exception = true;
   }
   EXPECT_TRUE(exception);
+
+  // Большая матрица: A * A^(-1) = E
+  const int n = 10;
+  S21Matrix M2(n, n);
+  M2.FillMatrixRandom();
+  for (int i = 0; i < n; i++) M2.SetValue(i, i, M2(i, i) + 200);
+  S21Matrix Product = M2 * M2.InverseMatrix();
+  for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++)
+      EXPECT_NEAR(Product(y, x), (y == x) ? 1 : 0, 1e-12);
 }
 
 // ОПЕРАТОРЫ
@@ -340,6 +479,101 @@ TEST(Operators, MulMatrix) {
   EXPECT_TRUE(exception);
 }
 
+TEST(Operators, FusedExpression) {
+  S21Matrix A(4, 5), B(4, 5), C(4, 5);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  C.FillMatrixRandom();
+
+  S21Matrix R = A + B - C * 2.0;
+  ASSERT_EQ(R.GetRows(), 4);
+  ASSERT_EQ(R.GetCols(), 5);
+  for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 5; x++)
+      EXPECT_EQ(R(y, x), A(y, x) + B(y, x) - C(y, x) * 2.0);
+
+  // Выражение может читать матрицу, в которую записывается
+  S21Matrix A0 = A;
+  A = A + B * 0.5;
+  for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 5; x++) EXPECT_EQ(A(y, x), A0(y, x) + B(y, x) * 0.5);
+
+  A += B - C;
+  for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 5; x++)
+      EXPECT_EQ(A(y, x), A0(y, x) + B(y, x) * 0.5 + (B(y, x) - C(y, x)));
+
+  // Присвоение выражения другого размера и умножение выражения на матрицу
+  S21Matrix D(2, 4);
+  D.FillMatrix();
+  S21Matrix E(1, 1);
+  E = D * 3.0;
+  EXPECT_EQ(E.GetRows(), 2);
+  EXPECT_EQ(E(1, 3), 21);
+  S21Matrix F = (D + D) * A;
+  S21Matrix D2 = D * 2.0;
+  EXPECT_TRUE(F == D2 * A);
+
+  // Размеры проверяются при построении выражения, до вычисления
+  bool exception = false;
+  try {
+    S21Matrix M5(2, 2);
+    (void)(A + B - M5);
+  } catch (const std::out_of_range &e) {
+    exception = true;
+  }
+  EXPECT_TRUE(exception);
+}
+
+TEST(Operators, MoveAssignment) {
+  S21Matrix M1(4, 6);
+  M1.FillMatrix();
+  S21Matrix M2 = M1;
+  const double *data = M1.Data();
+
+  S21Matrix M3;
+  M3 = std::move(M1);
+  EXPECT_EQ(M3.Data(), data);
+  EXPECT_TRUE(M3 == M2);
+  EXPECT_EQ(M1.GetRows(), 0);
+  EXPECT_EQ(M1.GetCols(), 0);
+}
+
+TEST(Operators, RvalueReuseBuffer) {
+  S21Matrix A(3, 4), B(4, 3), C(3, 3);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  C.FillMatrixRandom();
+  S21Matrix AB = A * B;
+
+  S21Matrix T1 = A * B;
+  const double *data = T1.Data();
+  S21Matrix R1 = std::move(T1) + C;
+  EXPECT_EQ(R1.Data(), data);
+  S21Matrix E1 = AB + C;
+  EXPECT_TRUE(R1 == E1);
+
+  S21Matrix T2 = A * B;
+  data = T2.Data();
+  S21Matrix R2 = C - std::move(T2);
+  EXPECT_EQ(R2.Data(), data);
+  S21Matrix E2 = C - AB;
+  EXPECT_TRUE(R2 == E2);
+
+  S21Matrix T3 = A * B;
+  data = T3.Data();
+  S21Matrix R3 = std::move(T3) * 2.0 - C;
+  EXPECT_EQ(R3.Data(), data);
+  S21Matrix E3 = AB * 2.0 - C;
+  EXPECT_TRUE(R3 == E3);
+
+  // Цепочка временных матриц
+  S21Matrix R4 = A * B + C * C - C;
+  S21Matrix CC = C * C;
+  S21Matrix E4 = AB + CC - C;
+  EXPECT_TRUE(R4 == E4);
+}
+
 TEST(Operators, Equal) {
   S21Matrix M1;
   M1.FillMatrixRandom();
@@ -496,6 +730,1782 @@ TEST(Accessors_and_mutators, EditSize) {
     for (int x = 0; x < M1.GetCols(); x++, n++) EXPECT_EQ(M1(y, x), m4[n]);
 }
 
+// Новые столбцы - нули, даже если хвосты строк были изменены
+TEST(Accessors_and_mutators, EditSizeNewColumnsZero) {
+  S21Matrix A(2, 2), B(2, 2);
+  A.FillMatrix();
+  A.MulNumber(INFINITY);
+  A.EditSize(2, 3);
+  EXPECT_EQ(A(0, 2), 0);
+  EXPECT_EQ(A(1, 2), 0);
+
+  B.SetValue(0, 0, NAN);
+  A.EditSize(2, 2);
+  A.SumMatrix(B);
+  A.EditSize(2, 4);
+  for (int y = 0; y < 2; y++) {
+    EXPECT_EQ(A(y, 2), 0);
+    EXPECT_EQ(A(y, 3), 0);
+  }
+
+  // Запись в хвост строки через Data()
+  A.EditSize(2, 2);
+  A.Data()[2] = NAN;
+  A.Data()[A.Stride() + 3] = 5;
+  A.EditSize(3, 4);
+  for (int y = 0; y < 3; y++) {
+    EXPECT_EQ(A(y, 2), 0);
+    EXPECT_EQ(A(y, 3), 0);
+  }
+}
+
+// Рост по одной строке перевыделяет буфер O(log n) раз
+TEST(Accessors_and_mutators, GrowRowByRow) {
+  S21Matrix M(1, 5);
+  int reallocations = 0;
+  const double *data = M.Data();
+  for (int rows = 2; rows <= 1000; rows++) {
+    M.SetRows(rows);
+    for (int x = 0; x < 5; x++) M.SetValue(rows - 1, x, rows * 10 + x);
+    if (M.Data() != data) reallocations++;
+    data = M.Data();
+    EXPECT_GE(M.RowCapacity(), rows);
+  }
+  EXPECT_LE(reallocations, 11);
+  for (int y = 1; y < 1000; y++)
+    for (int x = 0; x < 5; x++) ASSERT_EQ(M(y, x), (y + 1) * 10 + x);
+
+  M.SetCols(7).SetCols(12);
+  EXPECT_EQ(M.GetCols(), 12);
+  EXPECT_EQ(M(999, 4), 10004);
+  EXPECT_EQ(M(999, 5), 0);
+  EXPECT_EQ(M(999, 11), 0);
+}
+
+TEST(Accessors_and_mutators, ReserveAndShrinkToFit) {
+  S21Matrix M(3, 3);
+  M.FillMatrix();
+  M.Reserve(100, 50);
+  EXPECT_EQ(M.GetRows(), 3);
+  EXPECT_EQ(M.GetCols(), 3);
+  EXPECT_GE(M.RowCapacity(), 100);
+  EXPECT_GE(M.ColCapacity(), 50);
+  EXPECT_EQ(M.ColCapacity(), M.Stride());
+  EXPECT_EQ(M(2, 2), 8);
+
+  // В пределах ёмкости буфер не меняется, отброшенное возвращается нулями
+  const double *data = M.Data();
+  M.EditSize(100, 50);
+  M.EditSize(2, 2);
+  M.EditSize(3, 3);
+  EXPECT_EQ(M.Data(), data);
+  double expected[9] = {0, 1, 0, 3, 4, 0, 0, 0, 0};
+  for (int y = 0, n = 0; y < 3; y++)
+    for (int x = 0; x < 3; x++, n++) EXPECT_EQ(M(y, x), expected[n]);
+
+  M.ShrinkToFit();
+  EXPECT_EQ(M.RowCapacity(), 3);
+  EXPECT_EQ(M.ColCapacity(), 8);
+  for (int y = 0, n = 0; y < 3; y++)
+    for (int x = 0; x < 3; x++, n++) EXPECT_EQ(M(y, x), expected[n]);
+  EXPECT_THROW(M.Reserve(-1, 3), std::out_of_range);
+}
+
+// Матрица с зарезервированными столбцами имеет другой шаг строки
+TEST(Accessors_and_mutators, ReservedStride) {
+  S21Matrix A(20, 10), B(20, 10);
+  A.FillMatrix();
+  B.FillMatrix();
+  A.Reserve(30, 40);
+  ASSERT_NE(A.Stride(), B.Stride());
+
+  EXPECT_TRUE(A == B);
+  S21Matrix Copy(A);
+  EXPECT_TRUE(Copy == B);
+  EXPECT_EQ(Copy.Stride(), B.Stride());
+  A += B;
+  B.MulNumber(2);
+  EXPECT_TRUE(A == B);
+  A -= B * 0.5;
+  B = S21Matrix(B * 0.5);
+  EXPECT_TRUE(A == B);
+  EXPECT_TRUE(A.Transpose() == B.Transpose());
+  EXPECT_TRUE(A * B.Transpose() == B * B.Transpose());
+
+  const std::string path = "s21_matrix_test.bin";
+  A.Save(path);
+  EXPECT_TRUE(S21Matrix::Load(path, S21LoadMode::kMapReadOnly) == B);
+  std::remove(path.c_str());
+}
+
+TEST(Accessors_and_mutators, DataAndStride) {
+  S21Matrix M1(5, 3);
+  M1.FillMatrix();
+  const double *data = M1.Data();
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data) % 64, 0u);
+  EXPECT_GE(M1.Stride(), M1.GetCols());
+  EXPECT_EQ(M1.Stride() % 8, 0);
+  for (int y = 0; y < M1.GetRows(); y++)
+    for (int x = 0; x < M1.GetCols(); x++)
+      EXPECT_EQ(data[y * M1.Stride() + x], M1(y, x));
+}
+
+// Методы пишут только в cols_ элементов строки: Inf и NaN не попадают в
+// выравнивающие хвосты
+TEST(Accessors_and_mutators, PaddingStaysZero) {
+  S21Matrix A(3, 3), B(3, 3);
+  A.FillMatrix();
+  B.SetValue(1, 1, NAN);
+  A.MulNumber(INFINITY);
+  A.SumMatrix(B);
+  A.SubMatrix(B);
+  const double *data = std::as_const(A).Data();
+  for (int y = 0; y < 3; y++)
+    for (int x = 3; x < A.Stride(); x++) EXPECT_EQ(data[y * A.Stride() + x], 0);
+  EXPECT_TRUE(std::isnan(A(1, 1)));
+  EXPECT_EQ(A(2, 2), INFINITY);
+}
+
+// ЯДРА
+
+TEST(Kernels, ElementWiseAllIsa) {
+  const S21Isa isas[] = {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                         S21Isa::kAvx512};
+  const std::size_t n = 37;  // Не кратно ширине ни одного вектора
+  double a[n], b[n], expected[n];
+  for (std::size_t i = 0; i < n; i++) {
+    a[i] = (double)i;
+    b[i] = (double)(n - i) / 4;
+  }
+
+  for (S21Isa isa : isas) {
+    const S21Kernels *kernels = S21GetKernels(isa);
+    if (!kernels) continue;
+    SCOPED_TRACE(kernels->name);
+
+    double dst[n];
+    std::memcpy(dst, a, sizeof(dst));
+    kernels->add(dst, b, n);
+    for (std::size_t i = 0; i < n; i++) expected[i] = a[i] + b[i];
+    EXPECT_TRUE(kernels->equal(dst, expected, n));
+
+    kernels->sub(dst, b, n);
+    kernels->scale(dst, 2.5, n);
+    for (std::size_t i = 0; i < n; i++) EXPECT_EQ(dst[i], a[i] * 2.5);
+
+    // Несовпадение в последнем элементе хвоста
+    std::memcpy(expected, dst, sizeof(dst));
+    expected[n - 1] += 1;
+    EXPECT_FALSE(kernels->equal(dst, expected, n));
+
+    kernels->zero(dst, n);
+    for (std::size_t i = 0; i < n; i++) EXPECT_EQ(dst[i], 0.0);
+  }
+}
+
+TEST(Kernels, TransposeAllIsa) {
+  const S21Isa isas[] = {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                         S21Isa::kAvx512};
+  const int rows = 19, cols = 13, lds = 16, ldd = 24;
+  double src[rows * lds];
+  for (int i = 0; i < rows * lds; i++) src[i] = (double)i;
+
+  for (S21Isa isa : isas) {
+    const S21Kernels *kernels = S21GetKernels(isa);
+    if (!kernels) continue;
+    SCOPED_TRACE(kernels->name);
+
+    double dst[cols * ldd] = {};
+    kernels->transpose(src, lds, dst, ldd, rows, cols);
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++)
+        EXPECT_EQ(dst[j * ldd + i], src[i * lds + j]);
+    // За пределами блока ничего не записано
+    for (int j = 0; j < cols; j++)
+      for (int i = rows; i < ldd; i++) EXPECT_EQ(dst[j * ldd + i], 0.0);
+  }
+}
+
+TEST(Kernels, GemmAllIsa) {
+  const int m = 53, k = 70, n = 61;
+  S21Matrix A(m, k), B(k, n), Expected(m, n);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  S21Gemm(*S21GetKernels(S21Isa::kScalar), m, n, k, A.Data(), A.Stride(),
+          B.Data(), B.Stride(), Expected.Data(), Expected.Stride());
+
+  const S21Isa isas[] = {S21Isa::kSse2, S21Isa::kAvx2, S21Isa::kAvx512};
+  for (S21Isa isa : isas) {
+    const S21Kernels *kernels = S21GetKernels(isa);
+    if (!kernels) continue;
+    SCOPED_TRACE(kernels->name);
+
+    S21Matrix C(m, n);
+    S21Gemm(*kernels, m, n, k, A.Data(), A.Stride(), B.Data(), B.Stride(),
+            C.Data(), C.Stride());
+    // Значения целые и небольшие - результат точный при любом порядке
+    EXPECT_TRUE(C == Expected);
+  }
+}
+
+TEST(Kernels, GemvAllIsa) {
+  // Размеры не кратны ни числу строк за проход, ни ширине вектора
+  const int m = 23, n = 37, lda = 40;
+  double a[m * lda], x[m], y[m], expected_y[m], yt[n], expected_yt[n];
+  for (int i = 0; i < m * lda; i++) a[i] = (double)(i % 17) - 8;
+  for (int i = 0; i < m; i++) x[i] = (double)(i % 5) - 2;
+  for (int i = 0; i < m; i++) {
+    expected_y[i] = 0;
+    for (int j = 0; j < n; j++) expected_y[i] += a[i * lda + j] * x[j % m];
+  }
+  for (int j = 0; j < n; j++) {
+    expected_yt[j] = 1;
+    for (int i = 0; i < m; i++) expected_yt[j] += x[i] * a[i * lda + j];
+  }
+  double xn[n];
+  for (int j = 0; j < n; j++) xn[j] = x[j % m];
+
+  const S21Isa isas[] = {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                         S21Isa::kAvx512};
+  for (S21Isa isa : isas) {
+    const S21Kernels *kernels = S21GetKernels(isa);
+    if (!kernels) continue;
+    SCOPED_TRACE(kernels->name);
+
+    kernels->gemv(a, lda, xn, y, m, n);
+    for (int i = 0; i < m; i++) EXPECT_EQ(y[i], expected_y[i]);
+    // gemv_t прибавляет к y
+    for (int j = 0; j < n; j++) yt[j] = 1;
+    kernels->gemv_t(a, lda, x, yt, m, n);
+    for (int j = 0; j < n; j++) EXPECT_EQ(yt[j], expected_yt[j]);
+  }
+}
+
+TEST(Kernels, StrassenGemm) {
+  // Нечётные размерности на разных уровнях рекурсии и неквадратные блоки
+  const int sizes[][3] = {{64, 64, 64}, {101, 77, 93}, {130, 31, 257}};
+  for (const auto &size : sizes) {
+    const int m = size[0], n = size[1], k = size[2];
+    S21Matrix A(m, k), B(k, n), Expected(m, n);
+    A.FillMatrixRandom();
+    B.FillMatrixRandom();
+    S21Gemm(m, n, k, A.Data(), A.Stride(), B.Data(), B.Stride(),
+            Expected.Data(), Expected.Stride());
+
+    for (int crossover : {1, 7, 16}) {
+      S21Matrix C(m, n);
+      S21StrassenGemm(m, n, k, A.Data(), A.Stride(), B.Data(), B.Stride(),
+                      C.Data(), C.Stride(), crossover);
+      EXPECT_TRUE(C == Expected) << m << " " << n << " " << k;
+
+      // Тот же результат с рабочим буфером вызывающего
+      std::vector<double> workspace(S21StrassenWorkspace(m, n, k, crossover));
+      S21Matrix D(m, n);
+      S21StrassenGemm(m, n, k, A.Data(), A.Stride(), B.Data(), B.Stride(),
+                      D.Data(), D.Stride(), crossover, workspace.data());
+      EXPECT_TRUE(D == Expected);
+    }
+  }
+  EXPECT_EQ(S21StrassenWorkspace(100, 100, 100, 100), 0u);
+}
+
+TEST(Kernels, MulPolicy) {
+  S21Matrix A(70, 90), B(90, 50);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  S21Matrix Classic(A), Strassen(A), Auto(A);
+  Classic.MulMatrix(B, S21MulPolicy::kClassic);
+  Strassen.MulMatrix(B, S21MulPolicy::kStrassen);
+  Auto.MulMatrix(B);
+  EXPECT_TRUE(Classic == Strassen);
+  EXPECT_TRUE(Classic == Auto);
+  EXPECT_TRUE(Classic == A * B);
+  EXPECT_THROW(A.MulMatrix(A, S21MulPolicy::kStrassen), std::out_of_range);
+}
+
+// ПУЛ ПОТОКОВ
+
+TEST(ThreadPool, ParallelFor) {
+  S21SetNumThreads(4);
+  EXPECT_EQ(S21GetNumThreads(), 4);
+
+  std::vector<int> hits(10000, 0);
+  S21ThreadPool::Instance().ParallelFor(0, (int)hits.size(), 16,
+                                        [&](int lo, int hi) {
+                                          for (int i = lo; i < hi; i++)
+                                            hits[i]++;
+                                        });
+  for (int hit : hits) EXPECT_EQ(hit, 1);
+
+  S21SetNumThreads(0);
+  EXPECT_GE(S21GetNumThreads(), 1);
+}
+
+// Исключение из куска доходит до вызывающего, пул остаётся рабочим
+TEST(ThreadPool, Exceptions) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  S21SetNumThreads(4);
+  for (int bad : {0, 5000, 9999}) {
+    std::atomic<int> calls(0);
+    EXPECT_THROW(pool.ParallelFor(0, 10000, 16,
+                                  [&](int lo, int hi) {
+                                    calls++;
+                                    if (lo <= bad && bad < hi)
+                                      throw std::runtime_error("chunk");
+                                  }),
+                 std::runtime_error);
+    EXPECT_GE(calls, 1);
+  }
+  EXPECT_THROW(pool.ParallelFor(0, 10000, 16,
+                                [](int, int) { throw std::logic_error(""); }),
+               std::logic_error);
+
+  std::vector<int> hits(10000, 0);
+  pool.ParallelFor(0, (int)hits.size(), 16, [&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) hits[i]++;
+  });
+  for (int hit : hits) EXPECT_EQ(hit, 1);
+  S21SetNumThreads(0);
+}
+
+TEST(ThreadPool, LargeMatrices) {
+  S21Matrix M1(300, 257), M2(257, 300), M3(300, 257);
+  M1.FillMatrixRandom();
+  M2.FillMatrixRandom();
+  M3.FillMatrixRandom();
+
+  S21SetNumThreads(1);
+  S21Matrix Mul1 = M1 * M2, Sum1 = M1 + M3, Tr1 = M1.Transpose();
+  S21SetNumThreads(3);
+  S21Matrix Mul3 = M1 * M2, Sum3 = M1 + M3, Tr3 = M1.Transpose();
+  S21SetNumThreads(0);
+
+  EXPECT_TRUE(Mul1 == Mul3);
+  EXPECT_TRUE(Sum1 == Sum3);
+  EXPECT_TRUE(Tr1 == Tr3);
+}
+
+// МАТРИЦЫ ФИКСИРОВАННОГО РАЗМЕРА
+
+TEST(FixedMatrix, Constexpr) {
+  constexpr S21FixedMatrix<3, 3> M{2, 5, 7, 6, 3, 4, 5, -2, -3};
+  static_assert(M.Determinant() == -1, "determinant at compile time");
+  constexpr S21FixedMatrix<3, 3> Inverse = M.InverseMatrix();
+  static_assert(Inverse(0, 0) == 1 && Inverse(1, 0) == -38 &&
+                    Inverse(2, 2) == 24,
+                "inverse at compile time");
+  constexpr S21FixedMatrix<2, 3> A{1, 2, 3, 4, 5, 6};
+  static_assert((A * A.Transpose())(1, 1) == 77, "product at compile time");
+  constexpr S21FixedMatrix<4, 4> Four{1, 0, 2, -1, 3, 0, 0, 5,
+                                      2, 1, 4, -3, 1, 0, 5, 0};
+  static_assert(Four.Determinant() == 30, "closed form 4x4 determinant");
+  // Для 5x5 нужен выбор главного элемента: ведущие элементы нулевые
+  constexpr S21FixedMatrix<5, 5> Five{0, 2, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0,
+                                      2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 2};
+  static_assert(Five.Determinant() == 32, "LU determinant at compile time");
+  constexpr S21FixedMatrix<5, 5> Zero{};
+  static_assert(Zero.Determinant() == 0, "singular LU determinant");
+  EXPECT_TRUE(M * Inverse == (S21FixedMatrix<3, 3>{1, 0, 0, 0, 1, 0, 0, 0, 1}));
+}
+
+TEST(FixedMatrix, SameAsS21Matrix) {
+  S21Matrix Dynamic(4, 4), Other(4, 4);
+  Dynamic.FillMatrixRandom();
+  Other.FillMatrixRandom();
+  // Диагональное преобладание - матрица обратима
+  for (int i = 0; i < 4; i++) Dynamic.SetValue(i, i, 1000 + Dynamic(i, i));
+  S21FixedMatrix<4, 4> Fixed(Dynamic), FixedOther(Other);
+
+  EXPECT_TRUE(Fixed.ToMatrix() == Dynamic);
+  EXPECT_TRUE(static_cast<S21Matrix>(Fixed * FixedOther) == Dynamic * Other);
+  EXPECT_TRUE((Fixed + FixedOther).ToMatrix() == Dynamic + Other);
+  EXPECT_TRUE(Fixed.Transpose().ToMatrix() == Dynamic.Transpose());
+  EXPECT_NEAR(Fixed.Determinant(), Dynamic.Determinant(),
+              1e-9 * std::fabs(Dynamic.Determinant()));
+
+  S21Matrix Complements = Dynamic.CalcComplements();
+  S21Matrix Inverse = Dynamic.InverseMatrix();
+  S21FixedMatrix<4, 4> FixedComplements = Fixed.CalcComplements();
+  S21FixedMatrix<4, 4> FixedInverse = Fixed.InverseMatrix();
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++) {
+      EXPECT_NEAR(FixedComplements(i, j), Complements(i, j),
+                  1e-9 * std::fabs(Complements(i, j)) + 1e-9);
+      EXPECT_NEAR(FixedInverse(i, j), Inverse(i, j), 1e-12);
+    }
+}
+
+TEST(FixedMatrix, Large) {
+  S21Matrix Dynamic(6, 6);
+  Dynamic.FillMatrixRandom();
+  for (int i = 0; i < 6; i++) Dynamic.SetValue(i, i, 1000 + Dynamic(i, i));
+  S21FixedMatrix<6, 6> Fixed(Dynamic);
+  S21FixedMatrix<6, 6> Product = Fixed * Fixed.InverseMatrix();
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      EXPECT_NEAR(Product(i, j), i == j ? 1.0 : 0.0, 1e-12);
+  EXPECT_NEAR(Fixed.Determinant(), Dynamic.Determinant(),
+              1e-9 * std::fabs(Dynamic.Determinant()));
+}
+
+TEST(FixedMatrix, Exceptions) {
+  S21FixedMatrix<2, 2> Singular{1, 2, 2, 4};
+  EXPECT_THROW(Singular.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(Singular(2, 0), std::out_of_range);
+  EXPECT_THROW((S21FixedMatrix<2, 2>{1, 2, 3, 4, 5}), std::out_of_range);
+  S21Matrix Dynamic(2, 3);
+  EXPECT_THROW((S21FixedMatrix<2, 2>(Dynamic)), std::out_of_range);
+  S21FixedMatrix<1, 1> One{5};
+  EXPECT_EQ(One.CalcComplements()(0, 0), 1);
+  EXPECT_EQ(One.InverseMatrix()(0, 0), 0.2);
+}
+
+// РАЗРЕЖЕННЫЕ МАТРИЦЫ
+
+// Плотная матрица, в которой ненулевой примерно каждый period-й элемент
+S21Matrix SparseLike(int rows, int cols, int period) {
+  S21Matrix result(rows, cols);
+  for (int y = 0; y < rows; y++)
+    for (int x = 0; x < cols; x++)
+      if ((y * 7 + x * 13) % period == 0) result.SetValue(y, x, y - x + 0.5);
+  return result;
+}
+
+TEST(SparseMatrix, Conversions) {
+  S21Matrix Dense = SparseLike(30, 41, 11);
+  S21SparseMatrix Csr(Dense), Csc(Dense, S21SparseMatrix::Format::kCsc);
+
+  EXPECT_TRUE(S21SparseMatrix::IsSparseEnough(Dense));
+  EXPECT_FALSE(S21SparseMatrix::IsSparseEnough(Dense, 0.05));
+  EXPECT_LT(Csr.Density(), 0.1);
+  EXPECT_EQ(Csr.NonZeros(), Csc.NonZeros());
+  EXPECT_EQ((int)Csr.Offsets().size(), 31);
+  EXPECT_EQ((int)Csc.Offsets().size(), 42);
+  EXPECT_TRUE(Csr.ToDense() == Dense);
+  EXPECT_TRUE(Csc.ToDense() == Dense);
+  EXPECT_TRUE(Csr == Csc);
+  EXPECT_EQ(Csr(3, 1), Dense(3, 1));
+  EXPECT_EQ(Csc(29, 40), Dense(29, 40));
+  EXPECT_THROW(Csr(30, 0), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(0, 3), std::out_of_range);
+}
+
+TEST(SparseMatrix, SumAndTranspose) {
+  S21Matrix A = SparseLike(20, 25, 5), B = SparseLike(20, 25, 3);
+  S21SparseMatrix SparseA(A), SparseB(B, S21SparseMatrix::Format::kCsc);
+
+  EXPECT_TRUE((SparseA + SparseB).ToDense() == A + B);
+  EXPECT_TRUE((SparseA - SparseB).ToDense() == A - B);
+  EXPECT_TRUE((SparseA * 3.0).ToDense() == A * 3.0);
+  // Взаимно уничтожившиеся элементы не хранятся
+  EXPECT_EQ((SparseA - SparseA).NonZeros(), 0);
+
+  S21SparseMatrix Transposed = SparseA.Transpose();
+  EXPECT_EQ(Transposed.GetRows(), 25);
+  EXPECT_EQ(Transposed.GetFormat(), S21SparseMatrix::Format::kCsc);
+  EXPECT_TRUE(Transposed.ToDense() == A.Transpose());
+
+  S21SparseMatrix Other(3, 3);
+  EXPECT_THROW(SparseA += Other, std::out_of_range);
+}
+
+TEST(SparseMatrix, Products) {
+  S21Matrix A = SparseLike(33, 47, 6), B = SparseLike(47, 29, 4);
+  S21Matrix Dense(47, 29), Left(33, 47);
+  Dense.FillMatrixRandom();
+  Left.FillMatrixRandom();
+  // Порог 1 - всегда разреженные ядра, без перехода к плотному произведению
+  S21SparseMatrix SparseA(A, S21SparseMatrix::Format::kCsr, 1.0);
+  S21SparseMatrix SparseB(B, S21SparseMatrix::Format::kCsr, 1.0);
+  S21SparseMatrix CscA(A, S21SparseMatrix::Format::kCsc, 1.0);
+
+  // Все значения - небольшие полуцелые числа, поэтому суммы точные
+  EXPECT_TRUE(SparseA * Dense == A * Dense);
+  EXPECT_TRUE(CscA * Dense == A * Dense);
+  EXPECT_TRUE(Left * SparseB == Left * B);
+  EXPECT_TRUE((SparseA * SparseB).ToDense() == A * B);
+  EXPECT_TRUE((CscA * SparseB).ToDense() == A * B);
+  EXPECT_EQ((CscA * SparseB).GetFormat(), S21SparseMatrix::Format::kCsc);
+
+  S21SparseMatrix Product(SparseA);
+  Product *= SparseB;
+  EXPECT_TRUE(Product == SparseA * SparseB);
+  EXPECT_THROW(SparseA * SparseA, std::out_of_range);
+  EXPECT_THROW(SparseA * A, std::out_of_range);
+  EXPECT_THROW(A * SparseA, std::out_of_range);
+}
+
+TEST(SparseMatrix, DenseFallback) {
+  S21Matrix A = SparseLike(33, 47, 4), B = SparseLike(47, 29, 4);
+  S21Matrix Dense(47, 29), Left(33, 47);
+  Dense.FillMatrixRandom();
+  Left.FillMatrixRandom();
+  S21SparseMatrix SparseA(A, S21SparseMatrix::Format::kCsc);
+  S21SparseMatrix SparseB(B), Sparser(SparseLike(47, 29, 40));
+
+  EXPECT_EQ(SparseA.GetMaxDensity(), S21SparseMatrix::kDefaultMaxDensity);
+  EXPECT_TRUE(SparseA.PrefersDense());
+  EXPECT_FALSE(Sparser.PrefersDense());
+  EXPECT_TRUE(SparseA * Dense == A * Dense);
+  EXPECT_TRUE(Left * SparseB == Left * B);
+  S21SparseMatrix Product = SparseA * SparseB;
+  EXPECT_TRUE(Product.ToDense() == A * B);
+  EXPECT_EQ(Product.GetFormat(), S21SparseMatrix::Format::kCsc);
+  EXPECT_TRUE((SparseA * Sparser).ToDense() == A * Sparser.ToDense());
+
+  // Порог переходит к результатам операций
+  SparseA.SetMaxDensity(0.5);
+  EXPECT_FALSE(SparseA.PrefersDense());
+  EXPECT_EQ(SparseA.Transpose().GetMaxDensity(), 0.5);
+  EXPECT_EQ(SparseA.ToFormat(S21SparseMatrix::Format::kCsr).GetMaxDensity(),
+            0.5);
+  EXPECT_EQ((SparseA * SparseB).GetMaxDensity(), 0.5);
+
+  // Порог не выбирает форму хранения: плотная матрица сохраняется целиком
+  S21Matrix Full(4, 6);
+  Full.FillMatrix();
+  Full.SetValue(0, 0, 1);
+  S21SparseMatrix FullSparse(Full);
+  EXPECT_FALSE(S21SparseMatrix::IsSparseEnough(Full));
+  EXPECT_EQ(FullSparse.NonZeros(), 24);
+  EXPECT_TRUE(FullSparse.PrefersDense());
+  EXPECT_TRUE(FullSparse.ToDense() == Full);
+}
+
+// ДВОИЧНЫЕ ФАЙЛЫ
+
+TEST(BinaryFile, SaveAndLoad) {
+  const std::string path = "s21_matrix_test.bin";
+  S21Matrix M(37, 21);
+  M.FillMatrixRandom();
+  M.Save(path);
+
+  S21LoadMode modes[] = {S21LoadMode::kCopy, S21LoadMode::kMapReadOnly,
+                         S21LoadMode::kMapPrivate};
+  for (S21LoadMode mode : modes) {
+    S21Matrix Loaded = S21Matrix::Load(path, mode);
+    EXPECT_TRUE(Loaded == M);
+    EXPECT_EQ(Loaded.Stride(), M.Stride());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(
+                  static_cast<const S21Matrix &>(Loaded).Data()) %
+                  64,
+              0u);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(BinaryFile, MappedWrites) {
+  const std::string path = "s21_matrix_test.bin";
+  S21Matrix M(10, 10);
+  M.FillMatrix();
+  M.Save(path);
+
+  S21Matrix ReadOnly = S21Matrix::Load(path, S21LoadMode::kMapReadOnly);
+  S21Matrix Private = S21Matrix::Load(path, S21LoadMode::kMapPrivate);
+  const S21MatrixAllocator *mapping = ReadOnly.Allocator();
+  EXPECT_FALSE(mapping->Writable());
+  EXPECT_TRUE(Private.Allocator()->Writable());
+
+  // Запись в матрицу только для чтения сначала копирует её буфер
+  ReadOnly += M;
+  Private.MulNumber(2);
+  EXPECT_NE(ReadOnly.Allocator(), mapping);
+  EXPECT_TRUE(ReadOnly == M * 2.0);
+  EXPECT_TRUE(Private == M * 2.0);
+
+  // Файл не изменился
+  EXPECT_TRUE(S21Matrix::Load(path) == M);
+
+  // Перезапись файла, из которого отображена сама матрица
+  S21Matrix Mapped = S21Matrix::Load(path, S21LoadMode::kMapReadOnly);
+  Mapped = Mapped + M;
+  Mapped.Save(path);
+  EXPECT_TRUE(S21Matrix::Load(path, S21LoadMode::kMapReadOnly) == M * 2.0);
+  std::remove(path.c_str());
+}
+
+// Хвосты строк в файле не значимы: в матрице они становятся нулями
+TEST(BinaryFile, DirtyPadding) {
+  const std::string path = "s21_matrix_test.bin";
+  S21Matrix M(2, 3);
+  M.FillMatrix();
+  M.Save(path);
+  double garbage[2] = {NAN, INFINITY};
+  FILE *file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  for (int y = 0; y < 2; y++) {
+    std::fseek(file, sizeof(S21MatrixFileHeader) +
+                         (y * M.Stride() + 3) * sizeof(double),
+               SEEK_SET);
+    std::fwrite(&garbage[y], sizeof(double), 1, file);
+  }
+  std::fclose(file);
+
+  S21Matrix Copy = S21Matrix::Load(path);
+  const double *data = std::as_const(Copy).Data();
+  EXPECT_EQ(data[3], 0);
+  EXPECT_EQ(data[Copy.Stride() + 3], 0);
+
+  for (S21LoadMode mode :
+       {S21LoadMode::kMapReadOnly, S21LoadMode::kMapPrivate}) {
+    S21Matrix Mapped = S21Matrix::Load(path, mode);
+    Mapped.EditSize(2, 4);
+    EXPECT_EQ(Mapped(0, 3), 0);
+    EXPECT_EQ(Mapped(1, 3), 0);
+    EXPECT_EQ(Mapped(1, 2), 5);
+  }
+  S21Matrix Mapped = S21Matrix::Load(path, S21LoadMode::kMapReadOnly);
+  Mapped.SetValue(0, 0, 1);
+  EXPECT_EQ(std::as_const(Mapped).Data()[3], 0);
+  std::remove(path.c_str());
+}
+
+TEST(BinaryFile, Errors) {
+  const std::string path = "s21_matrix_test.bin";
+  EXPECT_THROW(S21Matrix::Load("no_such_file.bin"), std::runtime_error);
+
+  FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("not a matrix at all, but long enough to hold a header ...", file);
+  std::fclose(file);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+
+  // Обрезанные данные
+  S21Matrix M(5, 5);
+  M.Save(path);
+  EXPECT_EQ(truncate(path.c_str(), 100), 0);
+  EXPECT_THROW(S21Matrix::Load(path, S21LoadMode::kMapReadOnly),
+               std::runtime_error);
+
+  // Заголовки, где rows * stride * element переполняет uint64, а data_bytes
+  // равен обернувшемуся значению; для long double оно равно нулю, и файл
+  // из одного заголовка не выглядит обрезанным
+  S21MatrixFileHeader headers[] = {
+      S21MakeMatrixHeader(INT_MAX, INT_MAX, INT_MAX, kS21MatrixDtypeFloat64),
+      S21MakeMatrixHeader(1 << 30, 1 << 30, 1 << 30,
+                          kS21MatrixDtypeLongDouble)};
+  EXPECT_EQ(headers[1].data_bytes, 0u);
+  for (const S21MatrixFileHeader &header : headers) {
+    file = std::fopen(path.c_str(), "wb");
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fclose(file);
+    EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+    EXPECT_THROW(S21MatrixT<long double>::Load(path, S21LoadMode::kMapPrivate),
+                 std::runtime_error);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(BinaryFile, SaveRespectsUmask) {
+  const std::string path = "s21_matrix_test.bin";
+  mode_t old_mask = umask(027);
+  S21Matrix(3, 3).Save(path);
+  umask(old_mask);
+  struct stat info;
+  ASSERT_EQ(stat(path.c_str(), &info), 0);
+  EXPECT_EQ(info.st_mode & 0777, 0640u);
+  std::remove(path.c_str());
+}
+
+TEST(BinaryFile, StreamMultiply) {
+  const std::string a_path = "s21_matrix_a.bin", b_path = "s21_matrix_b.bin";
+  const std::string c_path = "s21_matrix_c.bin";
+  S21Matrix A(61, 75), B(75, 43);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  A.Save(a_path);
+  B.Save(b_path);
+
+  // Бюджет на плитки 16 x 16: много плиток с неполными краями
+  S21StreamMultiply(a_path, b_path, c_path, 6 * 16 * 16 * sizeof(double));
+  S21Matrix C = S21Matrix::Load(c_path, S21LoadMode::kMapReadOnly);
+  EXPECT_TRUE(C == A * B);
+
+  // Бюджет больше матриц: одна плитка
+  S21StreamMultiply(a_path, b_path, c_path);
+  EXPECT_TRUE(S21Matrix::Load(c_path) == A * B);
+
+  EXPECT_THROW(S21StreamMultiply(a_path, b_path, c_path, 1024),
+               std::out_of_range);
+  EXPECT_THROW(S21StreamMultiply(a_path, a_path, c_path), std::out_of_range);
+
+  // Результат в файл операнда не пишется, даже под другим путём
+  EXPECT_THROW(S21StreamMultiply(a_path, b_path, a_path), std::out_of_range);
+  EXPECT_THROW(S21StreamMultiply(a_path, b_path, "./" + b_path),
+               std::out_of_range);
+  EXPECT_TRUE(S21Matrix::Load(a_path) == A);
+  EXPECT_TRUE(S21Matrix::Load(b_path) == B);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+// ПАКЕТЫ МАТРИЦ
+
+// Пакет из count случайных матриц rows x cols и те же матрицы по отдельности
+S21MatrixBatch RandomBatch(int count, int rows, int cols,
+                           std::vector<S21Matrix> &matrices) {
+  S21MatrixBatch batch(count, rows, cols);
+  matrices.clear();
+  for (int b = 0; b < count; b++) {
+    S21Matrix m(rows, cols);
+    m.FillMatrixRandom();
+    for (int i = 0; i < rows; i++) m.SetValue(i, i % cols, m(i, i % cols) + 4);
+    batch.SetMatrix(b, m);
+    matrices.push_back(m);
+  }
+  return batch;
+}
+
+// Совпадение матриц с точностью eps (порядок операций в пакете другой)
+bool Near(S21Matrix a, S21Matrix b, double eps) {
+  bool result = a.GetRows() == b.GetRows() && a.GetCols() == b.GetCols();
+  for (int i = 0; result && i < a.GetRows(); i++)
+    for (int j = 0; result && j < a.GetCols(); j++)
+      result = std::fabs(a(i, j) - b(i, j)) <= eps;
+  return result;
+}
+
+TEST(MatrixBatch, MulAndTranspose) {
+  std::vector<S21Matrix> a, b;
+  S21MatrixBatch A = RandomBatch(21, 3, 5, a);
+  S21MatrixBatch B = RandomBatch(21, 5, 2, b);
+
+  S21MatrixBatch C = A * B, T = A.Transpose();
+  ASSERT_EQ(C.GetRows(), 3);
+  ASSERT_EQ(C.GetCols(), 2);
+  ASSERT_EQ(T.GetRows(), 5);
+  for (int i = 0; i < 21; i++) {
+    EXPECT_TRUE(C.GetMatrix(i) == a[i] * b[i]);
+    EXPECT_TRUE(T.GetMatrix(i) == a[i].Transpose());
+  }
+  EXPECT_EQ(T(20, 4, 2), A(20, 2, 4));
+
+  A *= B;
+  EXPECT_TRUE(A.GetMatrix(7) == a[7] * b[7]);
+  EXPECT_THROW(A * B, std::out_of_range);
+  EXPECT_THROW(A * RandomBatch(5, 2, 2, b), std::out_of_range);
+}
+
+TEST(MatrixBatch, DeterminantAndInverse) {
+  for (int n : {1, 2, 3, 4, 7}) {
+    std::vector<S21Matrix> a;
+    S21MatrixBatch A = RandomBatch(19, n, n, a);
+    std::vector<double> det = A.Determinant();
+    S21MatrixBatch I = A.InverseMatrix();
+    ASSERT_EQ(det.size(), 19u);
+    for (int i = 0; i < 19; i++) {
+      EXPECT_NEAR(det[i], a[i].Determinant(), 1e-9 * std::fabs(det[i]) + 1e-9);
+      EXPECT_TRUE(Near(I.GetMatrix(i), a[i].InverseMatrix(), 1e-12));
+    }
+  }
+
+  // Перестановка строк меняет знак; вырожденная матрица (с нулевой строкой,
+  // чтобы определитель был точно нулём) среди невырожденных
+  std::vector<S21Matrix> a;
+  S21MatrixBatch A = RandomBatch(10, 5, 5, a);
+  for (int j = 0; j < 5; j++) {
+    A(3, 0, j) = 0;
+    A(3, 1, j) = j + 1;
+    A(9, 4, j) = 0;
+  }
+  A(3, 0, 4) = 1;
+  std::vector<double> det = A.Determinant();
+  EXPECT_NEAR(det[3], A.GetMatrix(3).Determinant(), 1e-9);
+  EXPECT_EQ(det[9], 0);
+  EXPECT_THROW(A.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(S21MatrixBatch(4, 2, 3).Determinant(), std::out_of_range);
+  EXPECT_THROW(S21MatrixBatch(4, 2, 3).InverseMatrix(), std::out_of_range);
+}
+
+TEST(MatrixBatch, ParallelAndAccessors) {
+  std::vector<S21Matrix> a;
+  S21MatrixBatch A = RandomBatch(3001, 4, 4, a);
+  S21MatrixBatch serial(A);
+  serial.SetParallel(false);
+  EXPECT_TRUE(A.GetParallel());
+  EXPECT_FALSE(serial.GetParallel());
+
+  S21SetNumThreads(4);
+  S21MatrixBatch inverse = A.InverseMatrix();
+  S21MatrixBatch product = A * inverse;
+  S21SetNumThreads(0);
+  S21MatrixBatch expected = serial * serial.InverseMatrix();
+  S21Matrix identity(4, 4);
+  for (int i = 0; i < 4; i++) identity.SetValue(i, i, 1);
+  for (int b = 0; b < 3001; b += 100) {
+    EXPECT_TRUE(Near(product.GetMatrix(b), identity, 1e-12));
+    EXPECT_TRUE(Near(expected.GetMatrix(b), identity, 1e-12));
+  }
+
+  EXPECT_EQ(A.GetCount(), 3001);
+  EXPECT_THROW(A(3001, 0, 0), std::out_of_range);
+  EXPECT_THROW(A(0, 4, 0), std::out_of_range);
+  EXPECT_THROW(A.SetMatrix(0, S21Matrix(3, 4)), std::out_of_range);
+  EXPECT_THROW(A.GetMatrix(-1), std::out_of_range);
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::out_of_range);
+}
+
+// СТАТИСТИКА
+
+TEST(Stats, Operations) {
+  S21ResetStats();
+  S21Matrix a(64, 32), b(32, 16);
+  S21Matrix c = a * b;
+  S21Matrix d(c);
+  EXPECT_TRUE(d == c);
+  S21StatsSnapshot stats = S21GetStats();
+  const S21OpStats &mul = stats[S21StatsOp::kMulMatrix];
+  const S21OpStats &copy = stats[S21StatsOp::kCopyMatrix];
+
+  if (S21StatsEnabled()) {
+    EXPECT_EQ(mul.calls, 1u);
+    EXPECT_EQ(mul.flops, 2u * 64 * 32 * 16);
+    EXPECT_EQ(mul.sizes[6], 1u);  // max(64, 16) = 64 = 2^6
+    EXPECT_EQ(mul.allocations, 1u);
+    EXPECT_EQ(mul.allocated_bytes, 64u * 16 * sizeof(double));
+    EXPECT_EQ(copy.calls, 1u);
+    EXPECT_EQ(copy.allocated_bytes, 64u * 16 * sizeof(double));
+    EXPECT_EQ(stats[S21StatsOp::kEqMatrix].calls, 1u);
+    EXPECT_EQ(stats.allocations, 4u);
+    EXPECT_EQ(stats.deallocations, 0u);
+
+    // Дополнения вырожденной матрицы: буферы копии под LU и минора
+    // освобождаются внутри операции
+    S21Matrix singular(5, 5);
+    singular.CalcComplements();
+    stats = S21GetStats();
+    EXPECT_EQ(stats[S21StatsOp::kCalcComplements].calls, 1u);
+    EXPECT_GE(stats.deallocations, 2u);
+
+    // Повторные вызовы берут результат из кэша и операций не добавляют
+    S21Matrix m(6, 6);
+    m.FillMatrixRandom();
+    for (int i = 0; i < 6; i++) m.SetValue(i, i, 100 + m(i, i));
+    S21ResetStats();
+    m.Determinant();
+    m.Determinant();
+    m.InverseMatrix();
+    m.InverseMatrix();
+    stats = S21GetStats();
+    EXPECT_EQ(stats[S21StatsOp::kDeterminant].calls, 2u);
+    EXPECT_EQ(stats[S21StatsOp::kDeterminant].flops, 2u * 6 * 6 * 6 / 3);
+    // Определитель не сохраняет разложение, поэтому InverseMatrix
+    // раскладывает матрицу сама
+    EXPECT_EQ(stats[S21StatsOp::kInverseMatrix].flops, 2u * 6 * 6 * 6);
+  } else {
+    EXPECT_EQ(mul.calls, 0u);
+    EXPECT_EQ(copy.calls, 0u);
+    EXPECT_EQ(stats.allocations, 0u);
+  }
+
+  S21ResetStats();
+  stats = S21GetStats();
+  EXPECT_EQ(stats[S21StatsOp::kMulMatrix].calls, 0u);
+  EXPECT_EQ(stats.allocations, 0u);
+}
+
+TEST(Stats, ThreadsAndDump) {
+  S21ResetStats();
+  std::thread worker([] {
+    S21Matrix a(8, 8);
+    a.FillMatrix();
+    S21Matrix b = a + a * 2.0;
+    b.Transpose();
+  });
+  worker.join();
+  S21Matrix a(4, 4);
+  a += a;
+
+  S21StatsSnapshot stats = S21GetStats();
+  std::string text = S21StatsToText(stats), json = S21StatsToJson(stats);
+  EXPECT_NE(json.find("\"Transpose\": {\"calls\": "), std::string::npos);
+  EXPECT_NE(json.find("\"buffers\""), std::string::npos);
+  if (S21StatsEnabled()) {
+    // Счётчики завершившегося потока не теряются
+    EXPECT_EQ(stats[S21StatsOp::kTranspose].calls, 1u);
+    EXPECT_EQ(stats[S21StatsOp::kExpression].calls, 1u);
+    EXPECT_EQ(stats[S21StatsOp::kSumMatrix].calls, 1u);
+    EXPECT_NE(text.find("Transpose"), std::string::npos);
+    EXPECT_NE(json.find("\"enabled\": true"), std::string::npos);
+  } else {
+    EXPECT_EQ(text.find("Transpose"), std::string::npos);
+    EXPECT_NE(json.find("\"enabled\": false"), std::string::npos);
+  }
+  EXPECT_STREQ(S21StatsOpName(S21StatsOp::kGetMinor), "GetMinor");
+}
+
+// РАСПРЕДЕЛИТЕЛИ
+
+TEST(Allocators, PoolReusesBuffers) {
+  S21PoolAllocator &pool = S21PoolAllocator::Instance();
+  pool.Trim();
+  const double *first = nullptr;
+  {
+    S21AllocatorScope scope(pool);
+    S21Matrix M(50, 50);
+    EXPECT_EQ(M.Allocator(), &pool);
+    first = M.Data();
+  }
+  EXPECT_GT(pool.CachedBytes(), 0u);
+  {
+    S21AllocatorScope scope(pool);
+    S21Matrix M(50, 49);  // Тот же класс размера
+    EXPECT_EQ(M.Data(), first);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(M.Data()) % 64, 0u);
+  }
+  pool.Trim();
+  EXPECT_EQ(pool.CachedBytes(), 0u);
+}
+
+TEST(Allocators, ArenaScope) {
+  S21MatrixArena arena(1 << 16);
+  S21Matrix A(40, 40), B(40, 40);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  S21Matrix Expected = A * B + A;
+  {
+    S21AllocatorScope scope(arena);
+    S21Matrix Result = A * B + A;
+    EXPECT_EQ(Result.Allocator(), &arena);
+    EXPECT_TRUE(Result == Expected);
+    EXPECT_GT(arena.BytesUsed(), 0u);
+  }
+  // Вне области матрицы снова берут память из кучи
+  S21Matrix C(2, 2);
+  EXPECT_EQ(C.Allocator(), &S21HeapAllocator::Instance());
+
+  arena.Reset();
+  EXPECT_EQ(arena.BytesUsed(), 0u);
+  EXPECT_GT(arena.BytesReserved(), 0u);
+}
+
+TEST(Allocators, MoveKeepsAllocator) {
+  S21MatrixArena arena;
+  S21Matrix Outer(3, 3);
+  {
+    S21AllocatorScope scope(arena);
+    S21Matrix Inner(4, 4);
+    Inner.FillMatrix();
+    Outer = std::move(Inner);
+  }
+  // Буфер вернётся арене, хотя матрица разрушается вне области
+  EXPECT_EQ(Outer.Allocator(), &arena);
+  EXPECT_EQ(Outer(3, 3), 15.0);
+  Outer = S21Matrix(2, 2);
+  EXPECT_EQ(Outer.Allocator(), &S21HeapAllocator::Instance());
+}
+
+// ТИПЫ ЭЛЕМЕНТОВ
+
+template <class T>
+class ElementTypes : public ::testing::Test {};
+
+using S21ElementTypes = ::testing::Types<float, double, long double>;
+TYPED_TEST_SUITE(ElementTypes, S21ElementTypes);
+
+// Целые значения до 100 и суммы их произведений представимы точно во всех
+// трёх типах, поэтому результаты сравниваются с double без допуска
+TYPED_TEST(ElementTypes, ExactOperations) {
+  using Matrix = S21MatrixT<TypeParam>;
+  S21Matrix A(37, 21), B(37, 21), C(21, 45);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  C.FillMatrixRandom();
+  Matrix a(A), b(B), c(C);
+  EXPECT_EQ(a.Stride() * sizeof(TypeParam) % 64, 0u);
+
+  EXPECT_TRUE(S21Matrix(Matrix(a + b - a * 2.0)) == S21Matrix(A + B - A * 2.0));
+  Matrix sum(a);
+  sum.SumMatrix(b);
+  sum.SubMatrix(a);
+  EXPECT_TRUE(sum == b);
+  sum.MulNumber(3);
+  EXPECT_EQ(sum(4, 7), (TypeParam)(B(4, 7) * 3));
+  EXPECT_TRUE(S21Matrix(a.Transpose()) == A.Transpose());
+  EXPECT_TRUE(S21Matrix(a * c) == A * C);
+  EXPECT_THROW(a * b, std::out_of_range);
+
+  Matrix square(S21Matrix(70, 70));
+  square.FillMatrix();
+  Matrix copy(square);
+  square.TransposeInPlace();
+  EXPECT_TRUE(square == copy.Transpose());
+}
+
+TYPED_TEST(ElementTypes, KernelsAllIsa) {
+  using T = TypeParam;
+  const S21Isa isas[] = {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                         S21Isa::kAvx512};
+  const std::size_t n = 37;
+  T a[n], b[n], dst[n];
+  for (std::size_t i = 0; i < n; i++) {
+    a[i] = (T)i;
+    b[i] = (T)(n - i) / 4;
+  }
+  const int m = 53, k = 70, cols = 61;
+  S21Matrix A(m, k), B(k, cols);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  S21MatrixT<T> ta(A), tb(B);
+
+  for (S21Isa isa : isas) {
+    const S21KernelsT<T> *kernels = S21GetKernels<T>(isa);
+    if (!kernels) continue;
+    SCOPED_TRACE(kernels->name);
+
+    std::memcpy(dst, a, sizeof(dst));
+    kernels->add(dst, b, n);
+    kernels->scale(dst, 2, n);
+    kernels->sub(dst, b, n);
+    for (std::size_t i = 0; i < n; i++) EXPECT_EQ(dst[i], a[i] * 2 + b[i]);
+    EXPECT_TRUE(kernels->equal(dst, dst, n));
+    EXPECT_FALSE(kernels->equal(dst, a, n));
+    kernels->zero(dst, n);
+    for (std::size_t i = 0; i < n; i++) EXPECT_EQ(dst[i], 0);
+
+    S21MatrixT<T> tc(m, cols), td(k, m);
+    S21Gemm(*kernels, m, cols, k, ta.Data(), ta.Stride(), tb.Data(),
+            tb.Stride(), tc.Data(), tc.Stride());
+    EXPECT_TRUE(S21Matrix(tc) == A * B);
+    kernels->transpose(ta.Data(), ta.Stride(), td.Data(), td.Stride(), m, k);
+    EXPECT_TRUE(S21Matrix(td) == A.Transpose());
+  }
+  // Для long double есть только скалярные ядра
+  EXPECT_EQ(S21GetKernels<long double>().isa, S21Isa::kScalar);
+}
+
+TYPED_TEST(ElementTypes, DeterminantAndInverse) {
+  using Matrix = S21MatrixT<TypeParam>;
+  const double eps = std::is_same<TypeParam, float>::value ? 1e-4 : 1e-12;
+  // Диагональное преобладание: матрица хорошо обусловлена
+  S21Matrix A(12, 12), Identity(12, 12);
+  A.FillMatrixRandom();
+  for (int i = 0; i < 12; i++) {
+    A.SetValue(i, i, A(i, i) + 1000);
+    Identity.SetValue(i, i, 1);
+  }
+  Matrix a(A);
+
+  double det = A.Determinant();
+  EXPECT_NEAR((double)a.Determinant() / det, 1.0, eps);
+  Matrix inverse = a.InverseMatrix();
+  EXPECT_TRUE(Near(S21Matrix(inverse), A.InverseMatrix(), eps));
+  EXPECT_TRUE(Near(S21Matrix(a * inverse), Identity, eps));
+  EXPECT_TRUE(Near(S21Matrix(a.CalcComplements()), A.CalcComplements(),
+                   eps * std::fabs(det)));
+
+  Matrix singular(3, 3);
+  singular.FillMatrix();
+  EXPECT_EQ(singular.Determinant(), 0);
+  EXPECT_THROW(singular.InverseMatrix(), std::out_of_range);
+}
+
+TYPED_TEST(ElementTypes, SaveAndLoad) {
+  const std::string path = "s21_matrix_test.bin";
+  S21MatrixT<TypeParam> M(19, 23);
+  M.FillMatrixRandom();
+  M.SetValue(3, 5, (TypeParam)1 / 3);
+  M.Save(path);
+
+  S21LoadMode modes[] = {S21LoadMode::kCopy, S21LoadMode::kMapReadOnly};
+  for (S21LoadMode mode : modes) {
+    S21MatrixT<TypeParam> Loaded = S21MatrixT<TypeParam>::Load(path, mode);
+    EXPECT_TRUE(Loaded == M);
+  }
+  // Файл другого типа не загружается
+  if (std::is_same<TypeParam, double>::value) {
+    EXPECT_THROW(S21MatrixT<float>::Load(path), std::runtime_error);
+  } else {
+    EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  }
+  std::remove(path.c_str());
+}
+
+// Матрица Гильберта 10 x 10 (число обусловленности около 1e13): обратная в
+// long double заметно точнее, чем в double
+TEST(ElementTypesPrecision, IllConditionedInverse) {
+  const int n = 10;
+  S21MatrixT<long double> H(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) H.SetValue(i, j, 1.0L / (i + j + 1));
+  S21Matrix D(H);
+
+  S21MatrixT<long double> long_residual = H * H.InverseMatrix();
+  S21Matrix residual = D * D.InverseMatrix();
+  long double long_error = 0, error = 0;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) {
+      long double one = i == j ? 1 : 0;
+      long_error = std::max(long_error, std::fabs(long_residual(i, j) - one));
+      error = std::max(error, std::fabs(residual(i, j) - one));
+    }
+  EXPECT_LT(long_error * 100, error);
+}
+
+// ПРЕДСТАВЛЕНИЯ
+
+TEST(MatrixView, BlockAccess) {
+  S21Matrix M(5, 6);
+  M.FillMatrix();
+  S21MatrixView block = M.Block(1, 2, 3, 3);
+  EXPECT_EQ(block.GetRows(), 3);
+  EXPECT_EQ(block.GetCols(), 3);
+  EXPECT_EQ(block.Stride(), M.Stride());
+  EXPECT_EQ(block(0, 0), 8);
+  EXPECT_EQ(block(2, 1), 21);
+  EXPECT_EQ(block.Row(1)(0, 2), 16);
+  EXPECT_EQ(block.Col(2)(2, 0), 22);
+
+  // Запись через представление меняет саму матрицу
+  block(0, 0) = -1;
+  block.SetValue(2, 2, -2);
+  EXPECT_EQ(M(1, 2), -1);
+  EXPECT_EQ(M(3, 4), -2);
+
+  EXPECT_EQ(M.Block(5, 6, 0, 0).GetRows(), 0);
+  EXPECT_THROW(M.Block(4, 0, 2, 1), std::out_of_range);
+  EXPECT_THROW(M.Block(0, -1, 1, 1), std::out_of_range);
+  EXPECT_THROW(block.Block(1, 1, 3, 1), std::out_of_range);
+  EXPECT_THROW(block(3, 0), std::out_of_range);
+  EXPECT_THROW(M.Row(5), std::out_of_range);
+}
+
+TEST(MatrixView, ArithmeticOnBlocks) {
+  S21Matrix M(6, 7), N(6, 7);
+  M.FillMatrix();
+  N.FillMatrix();
+  S21Matrix Expected(M);
+  for (int i = 2; i < 5; i++)
+    for (int j = 1; j < 6; j++)
+      Expected.SetValue(i, j, (M(i, j) + N(i - 2, j) - 1) * 3);
+
+  S21MatrixView block = M.Block(2, 1, 3, 5);
+  const S21Matrix &Source = N;
+  S21ConstMatrixView other = Source.Block(0, 1, 3, 5);
+  block += other;
+  block.SubMatrix(S21Matrix(3, 5).View());
+  S21Matrix Ones(3, 5);
+  Ones.View().Fill(1);
+  block -= Ones.View();
+  block *= 3;
+  EXPECT_TRUE(M == Expected);
+  EXPECT_TRUE(block == Expected.Block(2, 1, 3, 5));
+  EXPECT_FALSE(block.EqMatrix(other));
+  EXPECT_THROW(block += Ones.Block(0, 0, 3, 4), std::out_of_range);
+}
+
+// Сдвиг блока внутри одной матрицы в обе стороны
+TEST(MatrixView, AssignOverlapping) {
+  S21Matrix M(8, 8);
+  M.FillMatrix();
+  S21Matrix Source(M);
+  M.Block(2, 3, 5, 5).Assign(M.Block(0, 0, 5, 5));
+  for (int i = 0; i < 5; i++)
+    for (int j = 0; j < 5; j++) EXPECT_EQ(M(i + 2, j + 3), Source(i, j));
+
+  M = Source;
+  M.Block(0, 0, 5, 5).Assign(M.Block(2, 3, 5, 5));
+  for (int i = 0; i < 5; i++)
+    for (int j = 0; j < 5; j++) EXPECT_EQ(M(i, j), Source(i + 2, j + 3));
+}
+
+TEST(MatrixView, Expressions) {
+  S21Matrix A(4, 4), B(4, 4);
+  A.FillMatrix();
+  B.FillMatrix();
+  B.MulNumber(-1);
+
+  S21Matrix Sum = A.Block(1, 1, 3, 3) + B.Block(0, 0, 3, 3) * 2.0;
+  EXPECT_EQ(Sum.GetRows(), 3);
+  EXPECT_EQ(Sum(0, 0), A(1, 1) - 2 * A(0, 0));
+  EXPECT_EQ(Sum(2, 1), A(3, 2) - 2 * A(2, 1));
+
+  S21Matrix Copy(B.Row(3));
+  EXPECT_EQ(Copy.GetRows(), 1);
+  EXPECT_EQ(Copy(0, 2), B(3, 2));
+
+  A.Row(0).Assign(A.Row(1) + A.Row(2));
+  EXPECT_EQ(A(0, 3), 7 + 11);
+  A.Block(1, 0, 3, 1) += Sum.Col(0) + A.Block(1, 1, 3, 1) * 0.0;
+  EXPECT_EQ(A(1, 0), 4 + Sum(0, 0));
+  EXPECT_EQ(A(3, 0), 12 + Sum(2, 0));
+  EXPECT_THROW(A.Row(0).Assign(A.Col(0) * 1.0), std::out_of_range);
+}
+
+TEST(MatrixView, AssignProduct) {
+  S21Matrix A(40, 50), B(60, 70), C(45, 45);
+  A.FillMatrixRandom();
+  B.FillMatrixRandom();
+  C.FillMatrixRandom();
+  S21Matrix Before(C);
+
+  S21ConstMatrixView a = static_cast<const S21Matrix &>(A).Block(3, 5, 30, 20);
+  S21ConstMatrixView b = static_cast<const S21Matrix &>(B).Block(7, 9, 20, 40);
+  S21Matrix Expected = S21Matrix(a) * S21Matrix(b);
+  C.Block(10, 2, 30, 40).AssignProduct(a, b);
+  EXPECT_TRUE(C.Block(10, 2, 30, 40) == Expected.View());
+  EXPECT_EQ(C(9, 2), Before(9, 2));
+  EXPECT_EQ(C(10, 42), Before(10, 42));
+
+  C.Block(10, 2, 30, 40).AssignProduct(a, b, true);
+  Expected.MulNumber(2);
+  EXPECT_TRUE(C.Block(10, 2, 30, 40) == Expected.View());
+  EXPECT_THROW(C.Block(0, 0, 30, 30).AssignProduct(a, b), std::out_of_range);
+}
+
+TEST(MatrixView, GetMinor) {
+  S21Matrix M(4, 5);
+  M.FillMatrix();
+  for (int oy = 0; oy < 4; oy++)
+    for (int ox = 0; ox < 5; ox++) {
+      S21Matrix Minor = M.GetMinor(oy, ox);
+      ASSERT_EQ(Minor.GetRows(), 3);
+      ASSERT_EQ(Minor.GetCols(), 4);
+      for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+          EXPECT_EQ(Minor(i, j), M(i + (i >= oy), j + (j >= ox)));
+    }
+  EXPECT_THROW(M.GetMinor(4, 0), std::out_of_range);
+}
+
+// Чтение блоков отображённой матрицы не копирует её, запись - копирует
+TEST(MatrixView, MappedMatrix) {
+  const std::string path = "s21_matrix_test.bin";
+  S21Matrix M(10, 10);
+  M.FillMatrix();
+  M.Save(path);
+
+  S21Matrix ReadOnly = S21Matrix::Load(path, S21LoadMode::kMapReadOnly);
+  const S21MatrixAllocator *mapping = ReadOnly.Allocator();
+  EXPECT_TRUE(static_cast<const S21Matrix &>(ReadOnly).Block(2, 2, 3, 3) ==
+              M.Block(2, 2, 3, 3));
+  EXPECT_EQ(ReadOnly.Allocator(), mapping);
+  ReadOnly.Block(2, 2, 3, 3).Fill(0);
+  EXPECT_NE(ReadOnly.Allocator(), mapping);
+  EXPECT_EQ(ReadOnly(3, 3), 0);
+  EXPECT_TRUE(S21Matrix::Load(path) == M);
+  std::remove(path.c_str());
+}
+
+// СИСТЕМЫ УРАВНЕНИЙ
+
+// Невырожденная матрица n x n с диагональным преобладанием
+S21Matrix DiagonallyDominant(int n) {
+  S21Matrix a(n, n);
+  a.FillMatrixRandom();
+  a.MulNumber(0.01);
+  for (int i = 0; i < n; i++) a.SetValue(i, i, a(i, i) + n);
+  return a;
+}
+
+TEST(LinearSystems, SolveSmall) {
+  S21Matrix A(3, 3), B(3, 2), Expected(3, 2);
+  double a[9] = {0, 2, 1, 1, 1, 1, 4, -1, 2};
+  double x[6] = {1, -2, 2, 0, -1, 3};
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) A.SetValue(i, j, a[i * 3 + j]);
+  for (int i = 0, n = 0; i < 3; i++)
+    for (int j = 0; j < 2; j++, n++) Expected.SetValue(i, j, x[n]);
+  B = A * Expected;
+  EXPECT_TRUE(Near(A.Solve(B), Expected, 1e-12));
+}
+
+// Разные пути подстановки: по столбцам (1 и 5 правых частей) и блоками
+TEST(LinearSystems, SolveLarge) {
+  const int n = 300;
+  S21Matrix A = DiagonallyDominant(n);
+  for (int nrhs : {1, 5, 40}) {
+    S21Matrix X(n, nrhs);
+    X.FillMatrixRandom();
+    S21Matrix B = A * X;
+    EXPECT_TRUE(Near(A.Solve(B), X, 1e-9)) << nrhs;
+  }
+}
+
+TEST(LinearSystems, FactorizationReuse) {
+  const int n = 200;
+  S21Matrix A = DiagonallyDominant(n);
+  S21LU lu(A);
+  EXPECT_EQ(lu.Size(), n);
+  EXPECT_FALSE(lu.Singular());
+
+  S21Matrix I(n, n);
+  for (int i = 0; i < n; i++) I.SetValue(i, i, 1);
+  EXPECT_TRUE(Near(A * lu.Inverse(), I, 1e-12));
+  EXPECT_TRUE(Near(lu.Inverse(), A.InverseMatrix(), 1e-15));
+
+  for (int k = 0; k < 10; k++) {
+    S21Matrix X(n, 1);
+    X.FillMatrixRandom();
+    S21Matrix B = A * X;
+    lu.SolveInPlace(B);
+    EXPECT_TRUE(Near(B, X, 1e-9));
+  }
+}
+
+// Определитель L * U известен: произведение диагонали U; порядок больше
+// ширины панели, чтобы разложение шло блоками
+TEST(LinearSystems, BlockedDeterminant) {
+  const int n = 150;
+  S21Matrix L(n, n), U(n, n);
+  double expected = 1;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) L.SetValue(i, j, (std::rand() % 100) / 100.0);
+    for (int j = i + 1; j < n; j++)
+      U.SetValue(i, j, (std::rand() % 100) / 100.0);
+    L.SetValue(i, i, 1);
+    U.SetValue(i, i, 1 + (i % 3) * 0.5);
+    expected *= U(i, i);
+  }
+  S21Matrix A = L * U;
+  EXPECT_NEAR(A.Determinant() / expected, 1, 1e-9);
+  EXPECT_NEAR(S21LU(A).Determinant() / expected, 1, 1e-9);
+}
+
+TEST(LinearSystems, Errors) {
+  S21Matrix A(3, 4), B(3, 1);
+  EXPECT_THROW(A.Solve(B), std::out_of_range);
+  EXPECT_THROW(S21LU{A}, std::out_of_range);
+
+  S21Matrix Singular(3, 3);
+  Singular.FillMatrix();
+  S21LU lu(Singular);
+  EXPECT_TRUE(lu.Singular());
+  EXPECT_EQ(lu.Determinant(), 0);
+  EXPECT_THROW(lu.Solve(B), std::out_of_range);
+  EXPECT_THROW(Singular.Solve(B), std::out_of_range);
+
+  S21Matrix Wrong(3, 1);
+  EXPECT_THROW(S21LU(DiagonallyDominant(2)).Solve(Wrong), std::out_of_range);
+}
+
+TEST(LinearSystems, OtherElementTypes) {
+  const int n = 100;
+  S21Matrix A = DiagonallyDominant(n), X(n, 3);
+  X.FillMatrixRandom();
+  S21Matrix B = A * X;
+  S21MatrixT<float> Xf = S21MatrixT<float>(A).Solve(S21MatrixT<float>(B));
+  S21MatrixT<long double> Xl =
+      S21LUT<long double>(S21MatrixT<long double>(A))
+          .Solve(S21MatrixT<long double>(B));
+  EXPECT_TRUE(Near(S21Matrix(Xf), X, 1e-3));
+  EXPECT_TRUE(Near(S21Matrix(Xl), X, 1e-9));
+}
+
+// ЗАПОМИНАНИЕ РАЗЛОЖЕНИЯ
+
+TEST(Memoization, VersionGrowsOnEveryChange) {
+  S21Matrix A = DiagonallyDominant(4), B = DiagonallyDominant(4);
+  std::uint64_t version = A.Version();
+  auto changed = [&] {
+    bool result = A.Version() > version;
+    version = A.Version();
+    return result;
+  };
+  A.Determinant();
+  A.InverseMatrix();
+  A.EqMatrix(B);
+  A.GetMinor(0, 0);
+  EXPECT_FALSE(changed());
+  A.SetValue(0, 0, 1);
+  EXPECT_TRUE(changed());
+  A.SumMatrix(B);
+  EXPECT_TRUE(changed());
+  A.SubMatrix(B);
+  EXPECT_TRUE(changed());
+  A.MulNumber(2);
+  EXPECT_TRUE(changed());
+  A.MulMatrix(B);
+  EXPECT_TRUE(changed());
+  A.TransposeInPlace();
+  EXPECT_TRUE(changed());
+  A += B * 2.0;
+  EXPECT_TRUE(changed());
+  A = B;
+  EXPECT_TRUE(changed());
+  A = S21Matrix(5, 5);
+  EXPECT_TRUE(changed());
+  A.EditSize(6, 5);
+  EXPECT_TRUE(changed());
+  A.Data();
+  EXPECT_TRUE(changed());
+  A.Block(0, 0, 2, 2);
+  EXPECT_TRUE(changed());
+  A.Reserve(10, 10);
+  EXPECT_FALSE(changed());
+}
+
+// После каждого изменения результаты совпадают с разложением заново
+TEST(Memoization, CacheFollowsChanges) {
+  const int n = 6;
+  S21Matrix A = DiagonallyDominant(n), B = DiagonallyDominant(n);
+  auto check = [&A] {
+    S21LU lu(A);
+    EXPECT_EQ(A.Determinant(), lu.Determinant());
+    EXPECT_EQ(A.Determinant(), lu.Determinant());
+    EXPECT_TRUE(A.InverseMatrix() == lu.Inverse());
+    EXPECT_TRUE(A.InverseMatrix() == lu.Inverse());
+  };
+  check();
+  A.SetValue(1, 2, 3);
+  check();
+  A.SumMatrix(B);
+  check();
+  A.MulNumber(0.5);
+  check();
+  A *= B;
+  check();
+  A.TransposeInPlace();
+  check();
+  A.Data()[0] += 1;
+  check();
+  A.Row(0) += B.Row(1);
+  check();
+  A = B;
+  check();
+  A.EditSize(n + 1, n + 1);
+  A.SetValue(n, n, 1);
+  check();
+}
+
+// Копия разделяет кэш с оригиналом, но меняется независимо от него
+TEST(Memoization, CopiesShareCache) {
+  S21Matrix A = DiagonallyDominant(5);
+  double det = A.Determinant();
+  S21Matrix B(A);
+  EXPECT_EQ(B.Determinant(), det);
+  B.MulNumber(2);
+  EXPECT_EQ(A.Determinant(), det);
+  EXPECT_NEAR(B.Determinant() / det, 32, 1e-12);
+  S21Matrix C = std::move(B);
+  EXPECT_NEAR(C.Determinant() / det, 32, 1e-12);
+}
+
+TEST(Memoization, SingularMatrix) {
+  S21Matrix A(4, 4);
+  A.FillMatrix();
+  EXPECT_EQ(A.Determinant(), 0);
+  EXPECT_THROW(A.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(A.InverseMatrix(), std::out_of_range);
+  for (int i = 0; i < 4; i++) A.SetValue(i, i, A(i, i) + 10);
+  EXPECT_NE(A.Determinant(), 0);
+  EXPECT_NO_THROW(A.InverseMatrix());
+}
+
+// Повторные вызовы не раскладывают матрицу заново; определитель берётся из
+// готового разложения, а без него считается в рабочем буфере
+TEST(Memoization, SingleFactorization) {
+  S21Matrix A = DiagonallyDominant(8), B(8, 1);
+  S21ResetStats();
+  for (int k = 0; k < 3; k++) {
+    A.InverseMatrix();
+    A.Determinant();
+    A.CalcComplements();
+    A.Solve(B);
+  }
+  S21StatsSnapshot stats = S21GetStats();
+  if (S21StatsEnabled()) {
+    EXPECT_EQ(stats[S21StatsOp::kLu].calls, 1u);
+    EXPECT_EQ(stats[S21StatsOp::kSolve].calls, 4u);
+    A.SetValue(0, 0, 1);
+    A.Determinant();
+    stats = S21GetStats();
+    EXPECT_EQ(stats[S21StatsOp::kLu].calls, 2u);
+  } else {
+    EXPECT_EQ(stats[S21StatsOp::kLu].calls, 0u);
+  }
+}
+
+// Запись через представление, указатель или итератор, полученные до
+// вызова, не возвращает устаревший результат
+TEST(Memoization, WritesThroughHandles) {
+  S21Matrix A = DiagonallyDominant(5), B(5, 1);
+  B.FillMatrix();
+  auto fresh = [&A, &B] {
+    S21LU lu(A);
+    EXPECT_EQ(A.Determinant(), lu.Determinant());
+    EXPECT_TRUE(A.InverseMatrix() == lu.Inverse());
+    EXPECT_TRUE(A.Solve(B) == lu.Solve(B));
+  };
+  S21MatrixView view = A.View();
+  fresh();
+  view(0, 0) = 5;
+  fresh();
+  double *data = A.Data();
+  data[1] = -3;
+  fresh();
+  auto it = A.begin();
+  it[7] = 2;
+  fresh();
+  S21Span row = A.RowSpan(4);
+  row[4] = 11;
+  fresh();
+
+  // Копия не получает кэш, который мог устареть
+  A.Determinant();
+  view(1, 1) = 9;
+  S21Matrix Copy(A);
+  EXPECT_EQ(Copy.Determinant(), S21LU(A).Determinant());
+  S21Matrix Assigned = DiagonallyDominant(5);
+  Assigned = A;
+  EXPECT_EQ(Assigned.Determinant(), S21LU(A).Determinant());
+
+  // Новый буфер снова кэширует: старые указатели больше недействительны
+  A.Reserve(10, 10);
+  S21ResetStats();
+  A.Determinant();
+  A.Determinant();
+  Copy.Determinant();
+  Copy.Determinant();
+  S21Matrix Minor = A.GetMinor(0, 0);
+  Minor.Determinant();
+  Minor.Determinant();
+  if (S21StatsEnabled()) {
+    EXPECT_EQ(S21GetStats()[S21StatsOp::kLu].calls, 2u);
+  }
+}
+
+// УМНОЖЕНИЕ НА ВЕКТОР
+
+// Произведение обычным GEMM для сравнения
+S21Matrix GemmProduct(S21Matrix &a, S21Matrix &b) {
+  S21Matrix c(a.GetRows(), b.GetCols());
+  S21Gemm(a.GetRows(), b.GetCols(), a.GetCols(), a.Data(), a.Stride(),
+          b.Data(), b.Stride(), c.Data(), c.Stride());
+  return c;
+}
+
+TEST(MulVector, MatchesMulMatrix) {
+  S21Matrix A(5, 3);
+  A.FillMatrix();
+  std::vector<double> y = A.MulVector({1, -2, 3});
+  EXPECT_EQ(y, std::vector<double>({4, 10, 16, 22, 28}));
+  std::vector<double> yt = A.VectorMul({1, 0, 0, 0, -1});
+  EXPECT_EQ(yt, std::vector<double>({-12, -12, -12}));
+
+  // MulMatrix со столбцом справа или строкой слева идёт через GEMV
+  const int m = 300, n = 257;
+  S21Matrix B(m, n), Column(n, 1), Row(1, m);
+  B.FillMatrixRandom();
+  Column.FillMatrixRandom();
+  Row.FillMatrixRandom();
+  EXPECT_TRUE(B * Column == GemmProduct(B, Column));
+  EXPECT_TRUE(Row * B == GemmProduct(Row, B));
+  S21Matrix Dot = Row * B * Column;
+  EXPECT_EQ(Dot.GetRows(), 1);
+  EXPECT_EQ(Dot.GetCols(), 1);
+
+  std::vector<double> x(n);
+  for (int j = 0; j < n; j++) x[j] = Column(j, 0);
+  std::vector<double> expected = B.MulVector(x);
+  S21Matrix Product = B * Column;
+  for (int i = 0; i < m; i++) EXPECT_EQ(Product(i, 0), expected[i]);
+}
+
+// Высокие, узкие и широкие матрицы: число потоков не меняет результат
+TEST(MulVector, Threads) {
+  const int shapes[][2] = {{20000, 7}, {3000, 300}, {70, 5000}};
+  for (const auto &shape : shapes) {
+    S21Matrix A(shape[0], shape[1]);
+    A.FillMatrixRandom();
+    std::vector<double> x(shape[1]), xt(shape[0]);
+    for (double &value : x) value = (std::rand() % 100) / 7.0;
+    for (double &value : xt) value = (std::rand() % 100) / 7.0;
+
+    S21SetNumThreads(1);
+    std::vector<double> y1 = A.MulVector(x), yt1 = A.VectorMul(xt);
+    S21SetNumThreads(3);
+    std::vector<double> y3 = A.MulVector(x), yt3 = A.VectorMul(xt);
+    S21SetNumThreads(0);
+    EXPECT_EQ(y1, y3) << shape[0] << " " << shape[1];
+    EXPECT_EQ(yt1, yt3) << shape[0] << " " << shape[1];
+
+    for (int j = 0; j < shape[1]; j += 97) {
+      double sum = 0;
+      for (int i = 0; i < shape[0]; i++) sum += xt[i] * A(i, j);
+      EXPECT_NEAR(yt1[j], sum, std::fabs(sum) * 1e-12);
+    }
+  }
+}
+
+TEST(MulVector, ElementTypesAndErrors) {
+  S21MatrixT<float> A(4, 19);
+  A.FillMatrix();
+  std::vector<float> x(19, 1), xt(4, 1);
+  std::vector<float> y = A.MulVector(x), yt = A.VectorMul(xt);
+  for (int i = 0; i < 4; i++) EXPECT_EQ(y[i], 19 * 19 * i + 171);
+  for (int j = 0; j < 19; j++) EXPECT_EQ(yt[j], 4 * j + 114);
+
+  S21Matrix B(3, 4);
+  EXPECT_THROW(B.MulVector(std::vector<double>(3)), std::out_of_range);
+  EXPECT_THROW(B.VectorMul(std::vector<double>(4)), std::out_of_range);
+}
+
+// ИТЕРАТОРЫ И СВЁРТКИ
+
+static_assert(std::is_default_constructible<S21RowIteratorT<double>>::value &&
+                  std::is_default_constructible<
+                      S21MatrixIteratorT<const double>>::value,
+              "iterators should be default constructible");
+#ifdef __cpp_lib_concepts
+static_assert(std::random_access_iterator<S21MatrixIteratorT<double>> &&
+                  std::random_access_iterator<S21RowIteratorT<double>> &&
+                  std::random_access_iterator<S21RowIteratorT<const double>>,
+              "iterators should model std::random_access_iterator");
+#endif
+
+TEST(Iterators, Elements) {
+  S21Matrix A(3, 5);
+  A.FillMatrix();
+  const S21Matrix &C = A;
+  std::vector<double> values(C.begin(), C.end());
+  ASSERT_EQ(values.size(), 15u);
+  for (int i = 0; i < 15; i++) EXPECT_EQ(values[i], i);
+
+  auto it = C.begin();
+  EXPECT_EQ(C.end() - it, 15);
+  EXPECT_EQ(it[7], 7);
+  EXPECT_EQ(*(it + 11), 11);
+  it += 14;
+  EXPECT_EQ(*it--, 14);
+  EXPECT_EQ(*it, 13);
+  EXPECT_TRUE(it < C.end() && it > C.begin());
+  EXPECT_EQ(std::accumulate(C.begin(), C.end(), 0.0), 105);
+
+  // Запись через итераторы - изменение матрицы
+  std::uint64_t version = A.Version();
+  for (double &value : A) value *= 2;
+  EXPECT_GT(A.Version(), version);
+  EXPECT_EQ(A(2, 4), 28);
+  std::reverse(A.begin(), A.end());
+  EXPECT_EQ(A(0, 0), 28);
+  EXPECT_EQ(A(2, 4), 0);
+  S21MatrixIteratorT<const double> cit = A.begin();
+  EXPECT_EQ(*cit, 28);
+}
+
+TEST(Iterators, RowSpans) {
+  S21Matrix A(4, 3);
+  A.FillMatrix();
+  S21ConstSpan row = std::as_const(A).RowSpan(1);
+  EXPECT_EQ(row.size(), 3);
+  EXPECT_EQ(row[2], 5);
+  EXPECT_EQ(std::accumulate(row.begin(), row.end(), 0.0), 12);
+  EXPECT_THROW(A.RowSpan(4), std::out_of_range);
+
+  int count = 0;
+  for (S21Span span : A.RowSpans()) {
+    for (double &value : span) value += count;
+    count++;
+  }
+  EXPECT_EQ(count, 4);
+  EXPECT_EQ(A.RowSpans().size(), 4);
+  EXPECT_EQ(A(3, 2), 14);
+  EXPECT_EQ((std::as_const(A).RowSpans().begin()[2][0]), 8);
+
+  // Полный набор операций итератора произвольного доступа
+  auto rows = std::as_const(A).RowSpans();
+  auto first = rows.begin(), last = rows.end();
+  EXPECT_TRUE(first < last && last > first && first <= first && last >= last);
+  EXPECT_TRUE((2 + first) == (first + 2));
+  EXPECT_EQ(last - (1 + first), 3);
+  // Строки упорядочены по первому элементу: двоичный поиск по ним
+  auto found = std::lower_bound(
+      first, last, 7.5,
+      [](S21ConstSpan row, double value) { return row[0] < value; });
+  EXPECT_EQ(found - first, 2);  // Первые элементы 0, 4, 8, 12
+  S21RowIteratorT<const double> null_row;
+  EXPECT_TRUE(null_row == S21RowIteratorT<const double>());
+  EXPECT_EQ(null_row - S21RowIteratorT<const double>(), 0);
+
+  // Сдвиг итератора без столбцов ничего не делает
+  S21MatrixIteratorT<double> none;
+  none += 0;
+  none += 3;
+  EXPECT_TRUE(none == S21MatrixIteratorT<double>());
+  S21Matrix Empty(std::move(A));
+  EXPECT_TRUE(A.begin() + 0 == A.end());
+  EXPECT_EQ(std::distance(A.begin(), A.end()), 0);
+}
+
+TEST(ElementWise, ApplyAndTransform) {
+  S21Matrix A(3, 17), B(3, 17);
+  A.FillMatrix();
+  B.FillMatrix();
+  A.Apply([](double x) { return 2 * x + 1; });
+  for (int j = 0; j < 17; j++) EXPECT_EQ(A(1, j), 2 * (17 + j) + 1);
+
+  S21Matrix C;
+  C.Transform(A, B, [](double x, double y) { return x - 2 * y; });
+  EXPECT_EQ(C.GetRows(), 3);
+  EXPECT_EQ(C.GetCols(), 17);
+  for (double value : std::as_const(C)) EXPECT_EQ(value, 1);
+  C.Transform(C, [](double x) { return -x; });
+  EXPECT_EQ(C.Sum(), -51);
+  A.Transform(A, A, [](double x, double y) { return x * y; });
+  EXPECT_EQ(A(0, 1), 9);
+  EXPECT_THROW(C.Transform(A, S21Matrix(3, 16), std::plus<double>()),
+               std::out_of_range);
+}
+
+TEST(ElementWise, Reductions) {
+  S21Matrix A(2, 3);
+  double a[6] = {1, -7, 3, 4, 5, -6};
+  for (int i = 0; i < 6; i++) A.SetValue(i / 3, i % 3, a[i]);
+  EXPECT_EQ(A.Sum(), 0);
+  EXPECT_EQ(A.Min(), -7);
+  EXPECT_EQ(A.Max(), 5);
+  EXPECT_EQ(A.NormMax(), 7);
+  EXPECT_EQ(A.Norm1(), 12);
+  EXPECT_EQ(A.NormInf(), 15);
+  EXPECT_NEAR(A.NormFrobenius(), std::sqrt(136.0), 1e-12);
+  EXPECT_EQ(A.Reduce(1, [](double x, double y) { return x * y; }), 2520);
+
+  S21MatrixT<float> F(5, 40);
+  F.FillMatrix();
+  EXPECT_EQ(F.Sum(), 199 * 200 / 2);
+  EXPECT_EQ(F.Max(), 199);
+
+  S21Matrix Empty(std::move(A));
+  EXPECT_EQ(A.Sum(), 0);
+  EXPECT_THROW(A.Min(), std::out_of_range);
+}
+
+// Большая матрица делится на блоки строк: число потоков не меняет
+// результат
+TEST(ElementWise, ParallelReductions) {
+  S21Matrix A(700, 301);
+  A.FillMatrixRandom();
+  A.Apply([](double x) { return x / 7 - 7; });
+  double sum = 0, min = A(0, 0), norm = 0;
+  for (int i = 0; i < 700; i++)
+    for (int j = 0; j < 301; j++) {
+      sum += A(i, j);
+      min = std::min(min, A(i, j));
+    }
+  for (int i = 0; i < 700; i++) {
+    double row = 0;
+    for (int j = 0; j < 301; j++) row += std::fabs(A(i, j));
+    norm = std::max(norm, row);
+  }
+
+  S21SetNumThreads(1);
+  double sum1 = A.Sum(), inf1 = A.NormInf();
+  S21SetNumThreads(3);
+  double sum3 = A.Sum(), inf3 = A.NormInf();
+  S21Matrix B;
+  B.Transform(A, [](double x) { return x + 7; });
+  S21SetNumThreads(0);
+
+  EXPECT_EQ(sum1, sum3);
+  EXPECT_EQ(inf1, inf3);
+  EXPECT_NEAR(sum1, sum, 1e-9 * std::fabs(sum));
+  EXPECT_NEAR(inf1, norm, 1e-9 * norm);
+  EXPECT_EQ(A.Min(), min);
+  EXPECT_NEAR(B.Sum(), sum + 7 * 700 * 301, 1e-6);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   std::cout << "Running tests:" << std::endl;
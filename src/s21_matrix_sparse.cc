@@ -0,0 +1,432 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "s21_matrix_thread_pool.h"
+
+namespace {
+
+// Произведения с объёмом работы (nnz * ширина плотной матрицы) меньше этого
+// порога не делятся между потоками
+constexpr double kParallelWork = 1 << 16;
+constexpr double kParallelGrain = 1 << 14;
+
+// y += a * x (цикл векторизуется компилятором)
+void Axpy(double *__restrict y, double a, const double *__restrict x, int n) {
+  for (int j = 0; j < n; j++) y[j] += a * x[j];
+}
+
+// Делит строки [0, rows) между потоками, если работа достаточно велика
+void ForEachRowRange(int rows, double work,
+                     const std::function<void(int, int)> &fn) {
+  if (work < kParallelWork || S21GetNumThreads() == 1) {
+    fn(0, rows);
+  } else {
+    int grain = (int)(kParallelGrain * rows / work);
+    S21ThreadPool::Instance().ParallelFor(0, rows, grain < 1 ? 1 : grain, fn);
+  }
+}
+
+// m в формате CSR; копия в storage создаётся, только если формат другой
+const S21SparseMatrix &AsCsr(const S21SparseMatrix &m,
+                             std::optional<S21SparseMatrix> &storage) {
+  if (m.GetFormat() == S21SparseMatrix::Format::kCsr) return m;
+  storage.emplace(m.ToFormat(S21SparseMatrix::Format::kCsr));
+  return *storage;
+}
+
+}  // namespace
+
+// КОНСТРУКТОРЫ
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, Format format)
+    : format_(format), rows_(rows), cols_(cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+  offsets_.assign(Outer() + 1, 0);
+}
+
+// Собирает CSR построчным проходом по плотной матрице; CSC получается
+// перестановкой CSR
+S21SparseMatrix::S21SparseMatrix(const S21Matrix &dense, Format format,
+                                 double max_density)
+    : format_(Format::kCsr), rows_(0), cols_(0), max_density_(max_density) {
+  rows_ = dense.GetRows();
+  cols_ = dense.GetCols();
+  offsets_.reserve(rows_ + 1);
+  offsets_.push_back(0);
+  for (int i = 0; i < rows_; i++) {
+    const double *row = dense.Data() + (std::ptrdiff_t)i * dense.Stride();
+    for (int j = 0; j < cols_; j++) {
+      if (row[j] != 0) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_.push_back((int)indices_.size());
+  }
+  if (format == Format::kCsc) *this = ToFormat(Format::kCsc);
+}
+
+// Считает ненулевые элементы, пока их доля не превысит max_density
+bool S21SparseMatrix::IsSparseEnough(const S21Matrix &dense,
+                                     double max_density) {
+  int rows = dense.GetRows(), cols = dense.GetCols();
+  double limit = max_density * rows * cols;
+  double count = 0;
+  for (int i = 0; i < rows && count <= limit; i++) {
+    const double *row = dense.Data() + (std::ptrdiff_t)i * dense.Stride();
+    for (int j = 0; j < cols; j++) count += (row[j] != 0);
+  }
+  return count <= limit;
+}
+
+// МЕТОДЫ
+
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix &other) const {
+  bool result = false;
+  if (rows_ == other.rows_ && cols_ == other.cols_) {
+    if (format_ != other.format_) {
+      result = EqMatrix(other.ToFormat(format_));
+    } else {
+      result = offsets_ == other.offsets_ && indices_ == other.indices_ &&
+               values_ == other.values_;
+    }
+  }
+  return result;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix &other) {
+  Merge(other, 1.0);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix &other) {
+  Merge(other, -1.0);
+}
+
+void S21SparseMatrix::MulNumber(const double num) {
+  if (num == 0) {
+    offsets_.assign(Outer() + 1, 0);
+    indices_.clear();
+    values_.clear();
+  } else {
+    for (double &value : values_) value *= num;
+  }
+}
+
+void S21SparseMatrix::MulMatrix(const S21SparseMatrix &other) {
+  *this = *this * other;
+}
+
+// Массивы CSR матрицы A - это массивы CSC матрицы A^T, поэтому
+// транспонирование только меняет формат и размеры, не переставляя данные
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix result(*this);
+  result.format_ = (format_ == Format::kCsr) ? Format::kCsc : Format::kCsr;
+  std::swap(result.rows_, result.cols_);
+  return result;
+}
+
+// Перестановка подсчётом: элементы раскладываются по новым внешним индексам
+// в порядке старых, поэтому индексы внутри выходят отсортированными
+S21SparseMatrix S21SparseMatrix::ToFormat(Format format) const {
+  if (format == format_) return *this;
+
+  S21SparseMatrix result(rows_, cols_, format);
+  result.max_density_ = max_density_;
+  std::vector<int> &offsets = result.offsets_;
+  for (int index : indices_) offsets[index + 1]++;
+  for (int k = 0; k < result.Outer(); k++) offsets[k + 1] += offsets[k];
+
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+  for (int k = 0; k < Outer(); k++) {
+    for (int p = offsets_[k]; p < offsets_[k + 1]; p++) {
+      int q = next[indices_[p]]++;
+      result.indices_[q] = k;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  double *data = result.WritableData();
+  std::ptrdiff_t stride = result.Stride();
+  for (int k = 0; k < Outer(); k++) {
+    for (int p = offsets_[k]; p < offsets_[k + 1]; p++) {
+      if (format_ == Format::kCsr)
+        data[k * stride + indices_[p]] = values_[p];
+      else
+        data[indices_[p] * stride + k] = values_[p];
+    }
+  }
+  return result;
+}
+
+bool S21SparseMatrix::PrefersDense() const { return Density() > max_density_; }
+
+// ПЕРЕГРУЗКА ОПЕРАТОРОВ
+
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix &other) const {
+  S21SparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix &other) const {
+  S21SparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+// Произведение считается в CSR и возвращается в формате и с порогом
+// левого операнда. Если оба операнда плотнее порога, перемножаются их
+// плотные копии.
+S21SparseMatrix S21SparseMatrix::operator*(
+    const S21SparseMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
+  if (PrefersDense() && other.PrefersDense()) {
+    return S21SparseMatrix(ToDense() * other.ToDense(), format_,
+                           max_density_);
+  }
+
+  std::optional<S21SparseMatrix> left, right;
+  S21SparseMatrix result =
+      ProductCsr(AsCsr(*this, left), AsCsr(other, right));
+  result.max_density_ = max_density_;
+  if (format_ == Format::kCsc) result = result.ToFormat(format_);
+  return result;
+}
+
+// Разреженная x плотная: строка i результата - сумма строк плотной
+// матрицы с весами из строки i разреженной. Число операций - nnz * cols.
+// Выше порога плотности - обычное плотное произведение.
+S21Matrix S21SparseMatrix::operator*(const S21Matrix &other) const {
+  if (cols_ != other.GetRows()) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
+  if (PrefersDense()) return ToDense() * other;
+
+  std::optional<S21SparseMatrix> storage;
+  const S21SparseMatrix &csr = AsCsr(*this, storage);
+  int n = other.GetCols();
+  S21Matrix result(rows_, n);
+  const double *b = other.Data();
+  double *c = result.WritableData();
+  std::ptrdiff_t ldb = other.Stride(), ldc = result.Stride();
+
+  ForEachRowRange(rows_, (double)NonZeros() * n, [&](int lo, int hi) {
+    for (int i = lo; i < hi; i++)
+      for (int p = csr.offsets_[i]; p < csr.offsets_[i + 1]; p++)
+        Axpy(c + i * ldc, csr.values_[p], b + csr.indices_[p] * ldb, n);
+  });
+
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const double num) const {
+  S21SparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix &other) const {
+  return EqMatrix(other);
+}
+
+S21SparseMatrix &S21SparseMatrix::operator+=(const S21SparseMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator-=(const S21SparseMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator*=(const S21SparseMatrix &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+// Двоичный поиск внутри строки (CSR) или столбца (CSC)
+double S21SparseMatrix::operator()(int i, int j) const {
+  if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range.");
+  }
+
+  int outer = (format_ == Format::kCsr) ? i : j;
+  int inner = (format_ == Format::kCsr) ? j : i;
+  auto begin = indices_.begin() + offsets_[outer];
+  auto end = indices_.begin() + offsets_[outer + 1];
+  auto it = std::lower_bound(begin, end, inner);
+  return (it != end && *it == inner) ? values_[it - indices_.begin()] : 0.0;
+}
+
+// Плотная x разреженная: строка i результата - сумма строк разреженной
+// матрицы с весами из строки i плотной; нулевые веса пропускаются.
+// Выше порога плотности - обычное плотное произведение.
+S21Matrix operator*(const S21Matrix &dense, const S21SparseMatrix &sparse) {
+  if (dense.GetCols() != sparse.rows_) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
+  if (sparse.PrefersDense()) return dense * sparse.ToDense();
+
+  std::optional<S21SparseMatrix> storage;
+  const S21SparseMatrix &csr = AsCsr(sparse, storage);
+  int m = dense.GetRows(), k = dense.GetCols();
+  S21Matrix result(m, sparse.cols_);
+  const double *a = dense.Data();
+  double *c = result.WritableData();
+  std::ptrdiff_t lda = dense.Stride(), ldc = result.Stride();
+
+  ForEachRowRange(m, (double)m * sparse.NonZeros(), [&](int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+      double *row = c + i * ldc;
+      for (int p = 0; p < k; p++) {
+        double weight = a[i * lda + p];
+        if (weight == 0) continue;
+        for (int q = csr.offsets_[p]; q < csr.offsets_[p + 1]; q++)
+          row[csr.indices_[q]] += weight * csr.values_[q];
+      }
+    }
+  });
+
+  return result;
+}
+
+// Accessors
+
+int S21SparseMatrix::GetRows() const { return rows_; }
+
+int S21SparseMatrix::GetCols() const { return cols_; }
+
+S21SparseMatrix::Format S21SparseMatrix::GetFormat() const { return format_; }
+
+int S21SparseMatrix::NonZeros() const { return (int)values_.size(); }
+
+double S21SparseMatrix::Density() const {
+  return (double)NonZeros() / ((double)rows_ * cols_);
+}
+
+double S21SparseMatrix::GetMaxDensity() const { return max_density_; }
+
+void S21SparseMatrix::SetMaxDensity(double max_density) {
+  max_density_ = max_density;
+}
+
+const std::vector<int> &S21SparseMatrix::Offsets() const { return offsets_; }
+
+const std::vector<int> &S21SparseMatrix::Indices() const { return indices_; }
+
+const std::vector<double> &S21SparseMatrix::Values() const { return values_; }
+
+// Вспомогательные
+
+int S21SparseMatrix::Outer() const {
+  return (format_ == Format::kCsr) ? rows_ : cols_;
+}
+
+// Слияние отсортированных строк (столбцов) двух матриц; элементы, которые
+// при сложении обратились в ноль, не сохраняются
+void S21SparseMatrix::Merge(const S21SparseMatrix &other, double sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range(
+        "Incorrect input: matriсes should have the same "
+        "size if you want to sum them.");
+  }
+  if (other.format_ != format_) {
+    Merge(other.ToFormat(format_), sign);
+    return;
+  }
+
+  std::vector<int> offsets(Outer() + 1, 0), indices;
+  std::vector<double> values;
+  indices.reserve(indices_.size() + other.indices_.size());
+  values.reserve(indices.capacity());
+
+  for (int k = 0; k < Outer(); k++) {
+    int p = offsets_[k], p_end = offsets_[k + 1];
+    int q = other.offsets_[k], q_end = other.offsets_[k + 1];
+    while (p < p_end || q < q_end) {
+      int index = 0;
+      double value = 0;
+      if (q == q_end || (p < p_end && indices_[p] < other.indices_[q])) {
+        index = indices_[p];
+        value = values_[p++];
+      } else if (p == p_end || other.indices_[q] < indices_[p]) {
+        index = other.indices_[q];
+        value = sign * other.values_[q++];
+      } else {
+        index = indices_[p];
+        value = values_[p++] + sign * other.values_[q++];
+      }
+      if (value != 0) {
+        indices.push_back(index);
+        values.push_back(value);
+      }
+    }
+    offsets[k + 1] = (int)indices.size();
+  }
+
+  offsets_.swap(offsets);
+  indices_.swap(indices);
+  values_.swap(values);
+}
+
+// Строка i результата накапливается в плотном массиве acc длины cols;
+// marker помнит, в какой строке столбец уже встречался
+S21SparseMatrix S21SparseMatrix::ProductCsr(const S21SparseMatrix &a,
+                                            const S21SparseMatrix &b) {
+  S21SparseMatrix result(a.rows_, b.cols_);
+  std::vector<double> acc(b.cols_, 0.0);
+  std::vector<int> marker(b.cols_, -1), columns;
+
+  for (int i = 0; i < a.rows_; i++) {
+    columns.clear();
+    for (int p = a.offsets_[i]; p < a.offsets_[i + 1]; p++) {
+      int k = a.indices_[p];
+      double weight = a.values_[p];
+      for (int q = b.offsets_[k]; q < b.offsets_[k + 1]; q++) {
+        int j = b.indices_[q];
+        if (marker[j] != i) {
+          marker[j] = i;
+          acc[j] = 0;
+          columns.push_back(j);
+        }
+        acc[j] += weight * b.values_[q];
+      }
+    }
+
+    std::sort(columns.begin(), columns.end());
+    for (int j : columns) {
+      if (acc[j] != 0) {
+        result.indices_.push_back(j);
+        result.values_.push_back(acc[j]);
+      }
+    }
+    result.offsets_[i + 1] = (int)result.indices_.size();
+  }
+
+  return result;
+}
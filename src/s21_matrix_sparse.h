@@ -0,0 +1,106 @@
+#ifndef __S21MATRIX_SPARSE_H__
+#define __S21MATRIX_SPARSE_H__
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Разреженная матрица в формате CSR (сжатые строки) или CSC (сжатые
+// столбцы). Хранятся только ненулевые элементы, поэтому память и число
+// операций растут с числом ненулевых элементов (nnz), а не с rows * cols.
+//
+// Каждая матрица хранит порог плотности. Он влияет только на произведения:
+// если доля ненулевых элементов больше порога, они считаются через плотную
+// S21Matrix, потому что разреженные ядра выгодны, только пока ненулевых
+// элементов мало. Форму хранения порог не выбирает: конструктор из плотной
+// матрицы всегда строит разреженную, а решать, стоит ли переходить к ней,
+// вызывающий код может через IsSparseEnough.
+//
+// Внутри каждой строки (CSR) или столбца (CSC) индексы отсортированы и не
+// повторяются, явных нулей нет. Операции над матрицами разных форматов
+// приводят второй операнд к формату первого.
+class S21SparseMatrix {
+ public:
+  enum class Format { kCsr, kCsc };
+
+  // Доля ненулевых элементов, до которой разреженные ядра выгоднее плотных
+  static constexpr double kDefaultMaxDensity = 0.1;
+
+  // Конструкторы
+  S21SparseMatrix(int rows, int cols,
+                  Format format = Format::kCsr);  // Нулевая матрица
+  // Из плотной: хранит все ненулевые элементы dense при любой плотности,
+  // max_density - порог для произведений
+  explicit S21SparseMatrix(const S21Matrix &dense,
+                           Format format = Format::kCsr,
+                           double max_density = kDefaultMaxDensity);
+
+  // Стоит ли хранить dense в разреженном виде: доля ненулевых элементов не
+  // больше max_density
+  static bool IsSparseEnough(const S21Matrix &dense,
+                             double max_density = kDefaultMaxDensity);
+
+  // Методы
+  bool EqMatrix(const S21SparseMatrix &other) const;
+  void SumMatrix(const S21SparseMatrix &other);  // Поэлементное сложение
+  void SubMatrix(const S21SparseMatrix &other);  // Поэлементное вычитание
+  void MulNumber(const double num);
+  void MulMatrix(const S21SparseMatrix &other);  // Разреженное произведение
+  S21SparseMatrix Transpose() const;
+  S21SparseMatrix ToFormat(Format format) const;  // Копия в другом формате
+  S21Matrix ToDense() const;
+  // Доля ненулевых элементов больше порога - произведения идут через
+  // плотную матрицу
+  bool PrefersDense() const;
+
+  // Перегрузка операторов
+  S21SparseMatrix operator+(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator*(const S21SparseMatrix &other) const;
+  S21Matrix operator*(const S21Matrix &other) const;  // Разреженная x плотная
+  S21SparseMatrix operator*(const double num) const;
+  bool operator==(const S21SparseMatrix &other) const;
+  S21SparseMatrix &operator+=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator-=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator*=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator*=(const double num);
+  double operator()(int i, int j) const;  // Элемент (строка, колонка)
+
+  // Accessors
+  int GetRows() const;
+  int GetCols() const;
+  Format GetFormat() const;
+  int NonZeros() const;
+  double Density() const;  // NonZeros() / (rows * cols)
+  double GetMaxDensity() const;
+  void SetMaxDensity(double max_density);
+  // Массивы формата: Offsets() - начала строк (CSR) или столбцов (CSC),
+  // размер на 1 больше их числа; Indices() - номера столбцов (CSR) или
+  // строк (CSC) ненулевых элементов; Values() - их значения
+  const std::vector<int> &Offsets() const;
+  const std::vector<int> &Indices() const;
+  const std::vector<double> &Values() const;
+
+ private:
+  int Outer() const;  // Число строк (CSR) или столбцов (CSC)
+  // this = this + sign * other (поэлементное слияние)
+  void Merge(const S21SparseMatrix &other, double sign);
+  // Произведение CSR x CSR по строкам (алгоритм Густавсона)
+  static S21SparseMatrix ProductCsr(const S21SparseMatrix &a,
+                                    const S21SparseMatrix &b);
+
+  Format format_;
+  int rows_, cols_;
+  double max_density_ = kDefaultMaxDensity;
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+
+  friend S21Matrix operator*(const S21Matrix &dense,
+                             const S21SparseMatrix &sparse);
+};
+
+// Плотная x разреженная
+S21Matrix operator*(const S21Matrix &dense, const S21SparseMatrix &sparse);
+
+#endif
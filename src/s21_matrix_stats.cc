@@ -0,0 +1,285 @@
+#include "s21_matrix_stats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Счётчик, который меняет только поток-владелец: обычное сложение поверх
+// relaxed-чтения и записи. Снимок из другого потока читает его без гонки.
+class Counter {
+ public:
+  void Add(std::uint64_t value) {
+    value_.store(value_.load(std::memory_order_relaxed) + value,
+                 std::memory_order_relaxed);
+  }
+  std::uint64_t Get() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+struct OpCounters {
+  Counter calls, nanoseconds, flops, allocations, allocated_bytes;
+  Counter sizes[kS21StatsSizeBuckets];
+};
+
+// Счётчики одного потока; регистрируются при первом обращении, при
+// завершении потока переносятся в общий итог
+struct ThreadCounters {
+  ThreadCounters();
+  ~ThreadCounters();
+  void AddTo(S21StatsSnapshot &stats) const;
+
+  OpCounters ops[kS21StatsOpCount];
+  Counter allocations, allocated_bytes, deallocations, freed_bytes;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<const ThreadCounters *> threads;
+  S21StatsSnapshot retired{};   // Итог завершившихся потоков
+  S21StatsSnapshot baseline{};  // Итог на момент S21ResetStats()
+};
+
+// Реестр не разрушается: потоки могут завершаться после статических объектов
+Registry &GetRegistry() {
+  static Registry *registry = new Registry();
+  return *registry;
+}
+
+thread_local ThreadCounters thread_counters;
+// Истина после разрушения thread_counters: операции статических матриц,
+// разрушаемых позже, не учитываются
+thread_local bool thread_counters_destroyed = false;
+thread_local int current_op = -1;  // Самая внутренняя идущая операция
+
+ThreadCounters *Counters() {
+  return thread_counters_destroyed ? nullptr : &thread_counters;
+}
+
+ThreadCounters::ThreadCounters() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+  Registry &registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    AddTo(registry.retired);
+    for (std::size_t i = 0; i < registry.threads.size(); i++)
+      if (registry.threads[i] == this) {
+        registry.threads[i] = registry.threads.back();
+        registry.threads.pop_back();
+        break;
+      }
+  }
+  thread_counters_destroyed = true;
+}
+
+void ThreadCounters::AddTo(S21StatsSnapshot &stats) const {
+  for (int op = 0; op < kS21StatsOpCount; op++) {
+    S21OpStats &to = stats.ops[op];
+    const OpCounters &from = ops[op];
+    to.calls += from.calls.Get();
+    to.nanoseconds += from.nanoseconds.Get();
+    to.flops += from.flops.Get();
+    to.allocations += from.allocations.Get();
+    to.allocated_bytes += from.allocated_bytes.Get();
+    for (int b = 0; b < kS21StatsSizeBuckets; b++)
+      to.sizes[b] += from.sizes[b].Get();
+  }
+  stats.allocations += allocations.Get();
+  stats.allocated_bytes += allocated_bytes.Get();
+  stats.deallocations += deallocations.Get();
+  stats.freed_bytes += freed_bytes.Get();
+}
+
+// Итог всех потоков с начала работы (вызывается под мьютексом реестра)
+S21StatsSnapshot Total(const Registry &registry) {
+  S21StatsSnapshot total = registry.retired;
+  for (const ThreadCounters *counters : registry.threads)
+    counters->AddTo(total);
+  return total;
+}
+
+int SizeBucket(int rows, int cols) {
+  int bucket = 0;
+  for (int n = rows > cols ? rows : cols;
+       n > 1 && bucket < kS21StatsSizeBuckets - 1; n >>= 1)
+    bucket++;
+  return bucket;
+}
+
+constexpr const char *kOpNames[kS21StatsOpCount] = {
+    "EqMatrix",        "SumMatrix",    "SubMatrix",     "MulNumber",
+    "MulMatrix",       "Transpose",    "TransposeInPlace",
+    "CalcComplements", "Determinant",  "InverseMatrix", "Expression",
+    "CopyMatrix",      "GetMinor",     "EditSize",      "Save",
+    "Load",            "LU",           "Solve",         "MulVector",
+    "Apply",           "Reduce"};
+
+}  // namespace
+
+const char *S21StatsOpName(S21StatsOp op) { return kOpNames[(int)op]; }
+
+S21StatsSnapshot S21GetStats() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  S21StatsSnapshot stats = Total(registry);
+  const S21StatsSnapshot &base = registry.baseline;
+
+  for (int op = 0; op < kS21StatsOpCount; op++) {
+    S21OpStats &to = stats.ops[op];
+    const S21OpStats &from = base.ops[op];
+    to.calls -= from.calls;
+    to.nanoseconds -= from.nanoseconds;
+    to.flops -= from.flops;
+    to.allocations -= from.allocations;
+    to.allocated_bytes -= from.allocated_bytes;
+    for (int b = 0; b < kS21StatsSizeBuckets; b++) to.sizes[b] -= from.sizes[b];
+  }
+  stats.allocations -= base.allocations;
+  stats.allocated_bytes -= base.allocated_bytes;
+  stats.deallocations -= base.deallocations;
+  stats.freed_bytes -= base.freed_bytes;
+  return stats;
+}
+
+// Счётчики чужих потоков менять нельзя, поэтому сброс запоминает текущий
+// итог, а снимки вычитают его
+void S21ResetStats() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.baseline = Total(registry);
+}
+
+std::string S21StatsToText(const S21StatsSnapshot &stats) {
+  std::string text;
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-17s %10s %12s %12s %10s %12s  %s\n",
+                "operation", "calls", "time_ms", "mflop", "allocs",
+                "alloc_bytes", "sizes (max dim >= n: calls)");
+  text += line;
+
+  for (int op = 0; op < kS21StatsOpCount; op++) {
+    const S21OpStats &s = stats.ops[op];
+    if (s.calls == 0) continue;
+    std::snprintf(line, sizeof(line),
+                  "%-17s %10llu %12.3f %12.3f %10llu %12llu ", kOpNames[op],
+                  (unsigned long long)s.calls, s.nanoseconds / 1e6,
+                  s.flops / 1e6, (unsigned long long)s.allocations,
+                  (unsigned long long)s.allocated_bytes);
+    text += line;
+    for (int b = 0; b < kS21StatsSizeBuckets; b++) {
+      if (s.sizes[b] == 0) continue;
+      std::snprintf(line, sizeof(line), " %d: %llu", 1 << b,
+                    (unsigned long long)s.sizes[b]);
+      text += line;
+    }
+    text += "\n";
+  }
+
+  std::snprintf(line, sizeof(line),
+                "buffers: %llu allocated (%llu bytes), %llu freed (%llu "
+                "bytes)\n",
+                (unsigned long long)stats.allocations,
+                (unsigned long long)stats.allocated_bytes,
+                (unsigned long long)stats.deallocations,
+                (unsigned long long)stats.freed_bytes);
+  text += line;
+  return text;
+}
+
+// Схема постоянная: все операции и все корзины присутствуют всегда
+std::string S21StatsToJson(const S21StatsSnapshot &stats) {
+  std::string json = "{\"enabled\": ";
+  json += S21StatsEnabled() ? "true" : "false";
+  json += ", \"operations\": {";
+
+  char field[128];
+  for (int op = 0; op < kS21StatsOpCount; op++) {
+    const S21OpStats &s = stats.ops[op];
+    std::snprintf(field, sizeof(field),
+                  "%s\"%s\": {\"calls\": %llu, \"nanoseconds\": %llu, ",
+                  op ? ", " : "", kOpNames[op], (unsigned long long)s.calls,
+                  (unsigned long long)s.nanoseconds);
+    json += field;
+    std::snprintf(field, sizeof(field),
+                  "\"flops\": %llu, \"allocations\": %llu, "
+                  "\"allocated_bytes\": %llu, \"sizes\": [",
+                  (unsigned long long)s.flops,
+                  (unsigned long long)s.allocations,
+                  (unsigned long long)s.allocated_bytes);
+    json += field;
+    for (int b = 0; b < kS21StatsSizeBuckets; b++) {
+      std::snprintf(field, sizeof(field), "%s%llu", b ? ", " : "",
+                    (unsigned long long)s.sizes[b]);
+      json += field;
+    }
+    json += "]}";
+  }
+
+  std::snprintf(field, sizeof(field),
+                "}, \"buffers\": {\"allocations\": %llu, ",
+                (unsigned long long)stats.allocations);
+  json += field;
+  std::snprintf(field, sizeof(field),
+                "\"allocated_bytes\": %llu, \"deallocations\": %llu, "
+                "\"freed_bytes\": %llu}}",
+                (unsigned long long)stats.allocated_bytes,
+                (unsigned long long)stats.deallocations,
+                (unsigned long long)stats.freed_bytes);
+  json += field;
+  return json;
+}
+
+// ТОЧКИ ЗАМЕРА
+
+void S21StatsRecordAllocation(std::size_t bytes) {
+  ThreadCounters *counters = Counters();
+  if (!counters) return;
+  counters->allocations.Add(1);
+  counters->allocated_bytes.Add(bytes);
+  if (current_op >= 0) {
+    counters->ops[current_op].allocations.Add(1);
+    counters->ops[current_op].allocated_bytes.Add(bytes);
+  }
+}
+
+void S21StatsRecordDeallocation(std::size_t bytes) {
+  ThreadCounters *counters = Counters();
+  if (!counters) return;
+  counters->deallocations.Add(1);
+  counters->freed_bytes.Add(bytes);
+}
+
+void S21StatsRecordFlops(double flops) {
+  ThreadCounters *counters = Counters();
+  if (!counters || current_op < 0) return;
+  counters->ops[current_op].flops.Add((std::uint64_t)flops);
+}
+
+S21StatsScope::S21StatsScope(S21StatsOp op, int rows, int cols, double flops)
+    : op_(op), parent_(current_op), start_(std::chrono::steady_clock::now()) {
+  current_op = (int)op;
+  ThreadCounters *counters = Counters();
+  if (!counters) return;
+  OpCounters &stats = counters->ops[(int)op];
+  stats.calls.Add(1);
+  stats.flops.Add((std::uint64_t)flops);
+  stats.sizes[SizeBucket(rows, cols)].Add(1);
+}
+
+S21StatsScope::~S21StatsScope() {
+  current_op = parent_;
+  ThreadCounters *counters = Counters();
+  if (!counters) return;
+  auto elapsed = std::chrono::steady_clock::now() - start_;
+  counters->ops[(int)op_].nanoseconds.Add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
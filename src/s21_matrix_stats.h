@@ -0,0 +1,128 @@
+#ifndef __S21MATRIX_STATS_H__
+#define __S21MATRIX_STATS_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Встроенная статистика операций библиотеки: число вызовов по методам,
+// гистограмма размеров, суммарное время, оценка числа операций с плавающей
+// точкой и выделения буферов.
+//
+// Включается при сборке макросом S21_MATRIX_STATS (make STATS=1), который
+// должен быть одинаковым для библиотеки и кода, подключающего её заголовки.
+// Без него точки замера раскрываются в пустоту, а S21GetStats() возвращает
+// нули.
+//
+// У каждого потока свои thread_local-счётчики. Их меняет только сам поток
+// (relaxed-чтение и запись, без блокировок и атомарных RMW), а снимок
+// складывает счётчики всех потоков и уже завершившихся.
+
+// Замеряемые операции. Время операции включает вложенные (InverseMatrix
+// содержит CopyMatrix), а выделения буферов приписываются самой внутренней.
+enum class S21StatsOp {
+  kEqMatrix,
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,  // MulMatrix, operator* и operator*= для матриц
+  kTranspose,
+  kTransposeInPlace,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kExpression,  // Вычисление ленивого выражения (+, - и * на число)
+  kCopyMatrix,
+  kGetMinor,
+  kEditSize,
+  kSave,
+  kLoad,
+  kLu,         // Разложение S21LU
+  kSolve,      // Решение систем (Solve, S21LU::Solve, S21LU::SolveInPlace)
+  kMulVector,  // MulVector и VectorMul
+  kApply,      // Apply и Transform
+  kReduce,     // Reduce и встроенные свёртки (Sum, нормы, Min, Max)
+  kCount
+};
+
+constexpr int kS21StatsOpCount = (int)S21StatsOp::kCount;
+
+// Корзина b гистограммы размеров - операции, у которых наибольшая из
+// размерностей лежит в [2^b, 2^(b+1)); последняя корзина - всё, что больше
+constexpr int kS21StatsSizeBuckets = 14;
+
+struct S21OpStats {
+  std::uint64_t calls;
+  std::uint64_t nanoseconds;
+  std::uint64_t flops;  // Оценка операций с плавающей точкой
+  std::uint64_t allocations;      // Буферы, выделенные внутри операции
+  std::uint64_t allocated_bytes;  // и их суммарный размер
+  std::uint64_t sizes[kS21StatsSizeBuckets];
+};
+
+// Снимок счётчиков всех потоков с момента последнего S21ResetStats()
+struct S21StatsSnapshot {
+  S21OpStats ops[kS21StatsOpCount];
+  std::uint64_t allocations;  // Все выделения и освобождения буферов матриц
+  std::uint64_t allocated_bytes;
+  std::uint64_t deallocations;
+  std::uint64_t freed_bytes;
+
+  const S21OpStats &operator[](S21StatsOp op) const { return ops[(int)op]; }
+};
+
+constexpr bool S21StatsEnabled() {
+#ifdef S21_MATRIX_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *S21StatsOpName(S21StatsOp op);  // "MulMatrix", "GetMinor", ...
+
+S21StatsSnapshot S21GetStats();
+void S21ResetStats();  // Следующие снимки считаются от текущих значений
+
+// Таблица для человека и JSON для сборщиков метрик
+std::string S21StatsToText(const S21StatsSnapshot &stats);
+std::string S21StatsToJson(const S21StatsSnapshot &stats);
+
+// ТОЧКИ ЗАМЕРА (используются через макросы ниже)
+
+void S21StatsRecordAllocation(std::size_t bytes);
+void S21StatsRecordDeallocation(std::size_t bytes);
+// Операции, число которых известно только внутри замера (например, работа
+// пропускается при попадании в кэш); приписываются самой внутренней операции
+void S21StatsRecordFlops(double flops);
+
+// Замер одного вызова: число вызовов и размер учитываются в конструкторе,
+// время - в деструкторе
+class S21StatsScope {
+ public:
+  S21StatsScope(S21StatsOp op, int rows, int cols, double flops);
+  S21StatsScope(const S21StatsScope &) = delete;
+  S21StatsScope &operator=(const S21StatsScope &) = delete;
+  ~S21StatsScope();
+
+ private:
+  S21StatsOp op_;
+  int parent_;  // Операция, внутри которой начался замер (-1 - нет)
+  std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef S21_MATRIX_STATS
+#define S21_STATS_SCOPE(op, rows, cols, flops) \
+  S21StatsScope s21_stats_scope(S21StatsOp::op, rows, cols, flops)
+#define S21_STATS_ALLOCATION(bytes) S21StatsRecordAllocation(bytes)
+#define S21_STATS_DEALLOCATION(bytes) S21StatsRecordDeallocation(bytes)
+#define S21_STATS_FLOPS(flops) S21StatsRecordFlops(flops)
+#else
+#define S21_STATS_SCOPE(op, rows, cols, flops) ((void)0)
+#define S21_STATS_ALLOCATION(bytes) ((void)0)
+#define S21_STATS_DEALLOCATION(bytes) ((void)0)
+#define S21_STATS_FLOPS(flops) ((void)0)
+#endif
+
+#endif
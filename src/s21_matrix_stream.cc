@@ -0,0 +1,245 @@
+#include "s21_matrix_stream.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+
+namespace {
+
+// Шаг строки в файле результата - как у буфера S21Matrix, чтобы результат
+// можно было загрузить отображением
+constexpr int kStrideStep = S21MatrixAllocator::kAlignment / sizeof(double);
+
+// Сторона плитки кратна kStrideStep и не меньше её
+constexpr int kMinTile = kStrideStep;
+
+// Открытый файл матрицы; дескриптор закрывается в деструкторе
+struct MatrixFile {
+  MatrixFile(const std::string &file_path, int flags)
+      : path(file_path), fd(open(file_path.c_str(), flags, 0644)) {
+    if (fd < 0) {
+      throw std::runtime_error("Can't open file '" + path +
+                               "': " + std::strerror(errno));
+    }
+  }
+  MatrixFile(const MatrixFile &) = delete;
+  MatrixFile &operator=(const MatrixFile &) = delete;
+  ~MatrixFile() { close(fd); }
+
+  // Смещение элемента (row, col) от начала файла
+  std::int64_t Offset(int row, int col) const {
+    std::int64_t index = (std::int64_t)row * header.stride + col;
+    return header.data_offset + index * (std::int64_t)sizeof(double);
+  }
+
+  // Тот же файл, что и other (в том числе под другим путём)
+  bool SameFile(const MatrixFile &other) const {
+    struct stat mine, theirs;
+    if (fstat(fd, &mine) != 0 || fstat(other.fd, &theirs) != 0) {
+      throw std::runtime_error("Can't stat file '" + path +
+                               "': " + std::strerror(errno));
+    }
+    return mine.st_dev == theirs.st_dev && mine.st_ino == theirs.st_ino;
+  }
+
+  std::string path;
+  int fd;
+  S21MatrixFileHeader header;
+};
+
+// Один поток, выполняющий задачи по очереди. Деструктор дожидается
+// завершения всех поставленных задач; исключение задачи попадает в её
+// std::future.
+class BackgroundThread {
+ public:
+  BackgroundThread() : stop_(false), thread_(&BackgroundThread::Loop, this) {}
+  BackgroundThread(const BackgroundThread &) = delete;
+  BackgroundThread &operator=(const BackgroundThread &) = delete;
+  ~BackgroundThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  std::future<void> Submit(std::function<void()> task) {
+    std::packaged_task<void()> job(std::move(task));
+    std::future<void> result = job.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(job));
+    }
+    wake_.notify_one();
+    return result;
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) break;
+      std::packaged_task<void()> job = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      job();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::packaged_task<void()>> queue_;
+  bool stop_;
+  std::thread thread_;  // Последним: запускается, когда остальное готово
+};
+
+// Читает блок rows x cols с углом (row, col) в tile с шагом строки ld
+void ReadTile(const MatrixFile &file, int row, int col, int rows, int cols,
+              double *tile, int ld) {
+  for (int i = 0; i < rows; i++)
+    S21ReadExact(file.fd, tile + (std::ptrdiff_t)i * ld,
+                 cols * sizeof(double), file.Offset(row + i, col), file.path);
+}
+
+void WriteTile(const MatrixFile &file, int row, int col, int rows, int cols,
+               const double *tile, int ld) {
+  for (int i = 0; i < rows; i++)
+    S21WriteExact(file.fd, tile + (std::ptrdiff_t)i * ld,
+                  cols * sizeof(double), file.Offset(row + i, col), file.path);
+}
+
+// Сторона квадратной плитки: в памяти 6 плиток (2 A, 2 B, 2 C)
+int TileSize(std::size_t memory_budget) {
+  double side = std::sqrt((double)memory_budget / (6 * sizeof(double)));
+  if (side < kMinTile) {
+    throw std::out_of_range(
+        "Incorrect input: memory budget is too small for streaming "
+        "multiplication.");
+  }
+  return (int)side / kStrideStep * kStrideStep;
+}
+
+}  // namespace
+
+// Плитки C обходятся построчно, для каждой суммируются произведения плиток
+// A и B по k. Шаг t - одна пара (A, B); пара шага t + 1 читается в фоне,
+// пока считается шаг t, а готовая плитка C пишется в фоне, пока считается
+// следующая. Чтение и запись идут в двух постоянных потоках: пул библиотеки
+// занят вычислениями, а ожидание ввода-вывода в нём остановило бы GEMM.
+void S21StreamMultiply(const std::string &a_path, const std::string &b_path,
+                       const std::string &c_path, std::size_t memory_budget) {
+  MatrixFile a(a_path, O_RDONLY), b(b_path, O_RDONLY);
+  a.header = S21ReadMatrixHeader(a.fd, a.path);
+  b.header = S21ReadMatrixHeader(b.fd, b.path);
+  if (a.header.cols != b.header.rows) {
+    throw std::out_of_range(
+        "Incorrect input. Number of first matrix columns "
+        "should be equal for second matrix rows");
+  }
+
+  const int m = (int)a.header.rows, k = (int)a.header.cols;
+  const int n = (int)b.header.cols;
+  const int tile = TileSize(memory_budget);
+  const int mb = std::min(tile, m), kb = std::min(tile, k);
+  const int nb = std::min(tile, n);
+
+  // Файл результата сразу получает полный размер (хвосты строк - нули).
+  // Он обрезается только после проверки, что это не один из операндов.
+  MatrixFile c(c_path, O_RDWR | O_CREAT);
+  if (c.SameFile(a) || c.SameFile(b)) {
+    throw std::out_of_range(
+        "Incorrect input: result file should differ from the operand "
+        "files.");
+  }
+  if (ftruncate(c.fd, 0)) {
+    throw std::runtime_error("Can't write file '" + c.path +
+                             "': " + std::strerror(errno));
+  }
+  c.header = S21MakeMatrixHeader(
+      m, n, (n + kStrideStep - 1) / kStrideStep * kStrideStep);
+  S21WriteExact(c.fd, &c.header, sizeof(c.header), 0, c.path);
+  if (ftruncate(c.fd, (off_t)(c.header.data_offset + c.header.data_bytes))) {
+    throw std::runtime_error("Can't write file '" + c.path +
+                             "': " + std::strerror(errno));
+  }
+
+  const int tiles_m = (m + mb - 1) / mb, tiles_n = (n + nb - 1) / nb;
+  const int tiles_k = (k + kb - 1) / kb;
+  const long steps = (long)tiles_m * tiles_n * tiles_k;
+
+  std::vector<double> a_tiles[2], b_tiles[2], c_tiles[2];
+  for (int s = 0; s < 2; s++) {
+    a_tiles[s].resize((std::size_t)mb * kb);
+    b_tiles[s].resize((std::size_t)kb * nb);
+    c_tiles[s].resize((std::size_t)mb * nb);
+  }
+
+  // Углы и размеры плиток шага t
+  struct Step {
+    int row, col, depth;  // Углы плиток: C(row, col), A(row, depth)
+    int rows, cols, depths;
+  };
+  auto step_at = [&](long t) {
+    Step step;
+    int p = (int)(t % tiles_k), ij = (int)(t / tiles_k);
+    step.row = ij / tiles_n * mb;
+    step.col = ij % tiles_n * nb;
+    step.depth = p * kb;
+    step.rows = std::min(mb, m - step.row);
+    step.cols = std::min(nb, n - step.col);
+    step.depths = std::min(kb, k - step.depth);
+    return step;
+  };
+  auto read_step = [&](long t) {
+    Step step = step_at(t);
+    ReadTile(a, step.row, step.depth, step.rows, step.depths,
+             a_tiles[t % 2].data(), kb);
+    ReadTile(b, step.depth, step.col, step.depths, step.cols,
+             b_tiles[t % 2].data(), nb);
+  };
+
+  // Фоновые потоки объявлены после буферов: при исключении их деструкторы
+  // дожидаются завершения задач, пока буферы ещё живы
+  BackgroundThread reader, writer;
+  std::future<void> next_read = reader.Submit([&] { read_step(0); });
+  std::future<void> pending_write;
+
+  for (long t = 0; t < steps; t++) {
+    next_read.get();
+    if (t + 1 < steps) next_read = reader.Submit([&, t] { read_step(t + 1); });
+
+    Step step = step_at(t);
+    int p = (int)(t % tiles_k);
+    double *c_tile = c_tiles[t / tiles_k % 2].data();
+    S21Gemm(step.rows, step.cols, step.depths, a_tiles[t % 2].data(), kb,
+            b_tiles[t % 2].data(), nb, c_tile, nb, p > 0);
+
+    if (p == tiles_k - 1) {
+      if (pending_write.valid()) pending_write.get();
+      pending_write = writer.Submit([&c, step, c_tile, nb] {
+        WriteTile(c, step.row, step.col, step.rows, step.cols, c_tile, nb);
+      });
+    }
+  }
+  if (pending_write.valid()) pending_write.get();
+}
@@ -0,0 +1,26 @@
+#ifndef __S21MATRIX_STREAM_H__
+#define __S21MATRIX_STREAM_H__
+
+#include <cstddef>
+#include <string>
+
+// Умножение матриц, не помещающихся в память (out-of-core).
+//
+// Операнды и результат - файлы в двоичном формате s21_matrix_io.h. В памяти
+// одновременно держатся только плитки: по две плитки A и B (пока считается
+// одна пара, следующая читается в фоне) и две плитки C (пока считается одна,
+// готовая пишется в файл в фоне). Размер плиток подбирается под бюджет.
+//
+// Бюджет покрывает буферы плиток; упаковочные буферы GEMM (несколько МБ на
+// поток) в него не входят.
+constexpr std::size_t kS21StreamDefaultBudget = std::size_t(256) << 20;
+
+// Пишет в c_path произведение матриц из a_path и b_path (C = A * B), держа
+// в памяти не больше memory_budget байт плиток. Несовпадение размеров,
+// слишком малый бюджет и c_path, указывающий на файл A или B, -
+// std::out_of_range (файлы не меняются), ошибки файлов - std::runtime_error.
+void S21StreamMultiply(const std::string &a_path, const std::string &b_path,
+                       const std::string &c_path,
+                       std::size_t memory_budget = kS21StreamDefaultBudget);
+
+#endif
@@ -0,0 +1,178 @@
+#include "s21_matrix_thread_pool.h"
+
+#include <cstdlib>
+
+namespace {
+
+// Истина в потоках пула и внутри ParallelFor - вложенные вызовы идут
+// последовательно
+thread_local bool inside_pool = false;
+
+// Выставляет inside_pool на время жизни объекта
+class InsidePoolScope {
+ public:
+  InsidePoolScope() : saved_(inside_pool) { inside_pool = true; }
+  ~InsidePoolScope() { inside_pool = saved_; }
+  InsidePoolScope(const InsidePoolScope &) = delete;
+  InsidePoolScope &operator=(const InsidePoolScope &) = delete;
+
+ private:
+  bool saved_;
+};
+
+int DefaultNumThreads() {
+  int result = 0;
+  const char *env = std::getenv("S21_NUM_THREADS");
+  if (env) result = std::atoi(env);
+  if (result <= 0) result = (int)std::thread::hardware_concurrency();
+  return (result <= 0) ? 1 : result;
+}
+
+}  // namespace
+
+S21ThreadPool &S21ThreadPool::Instance() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+S21ThreadPool::S21ThreadPool()
+    : num_threads_(1),
+      stop_(false),
+      generation_(0),
+      fn_(nullptr),
+      begin_(0),
+      end_(0),
+      chunk_(1),
+      chunks_(0),
+      next_chunk_(0),
+      finished_chunks_(0),
+      failed_(false),
+      busy_workers_(0) {
+  Start(DefaultNumThreads());
+}
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+void S21ThreadPool::SetNumThreads(int num_threads) {
+  if (num_threads <= 0) num_threads = DefaultNumThreads();
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  if (num_threads != num_threads_) {
+    Stop();
+    Start(num_threads);
+  }
+}
+
+int S21ThreadPool::GetNumThreads() { return num_threads_; }
+
+void S21ThreadPool::Start(int num_threads) {
+  stop_ = false;
+  num_threads_ = num_threads;
+  for (int i = 1; i < num_threads; i++)
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+  num_threads_ = 1;
+}
+
+void S21ThreadPool::WorkerLoop() {
+  inside_pool = true;
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) break;
+    seen = generation_;
+    busy_workers_++;
+
+    lock.unlock();
+    RunChunks();
+    lock.lock();
+
+    if (--busy_workers_ == 0) done_.notify_all();
+  }
+}
+
+// Исключение не покидает RunChunks: оно запоминается, а кусок всё равно
+// считается завершённым, иначе вызывающий поток ждал бы его вечно
+void S21ThreadPool::RunChunks() {
+  for (int chunk = next_chunk_++; chunk < chunks_; chunk = next_chunk_++) {
+    int lo = begin_ + chunk * chunk_;
+    int hi = (end_ - lo < chunk_) ? end_ : lo + chunk_;
+    if (!failed_) {
+      try {
+        (*fn_)(lo, hi);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+        failed_ = true;
+      }
+    }
+    finished_chunks_++;
+  }
+}
+
+void S21ThreadPool::ParallelFor(int begin, int end, int grain,
+                                const std::function<void(int, int)> &fn) {
+  if (begin >= end) return;
+  if (grain < 1) grain = 1;
+
+  int count = end - begin;
+  bool serial = inside_pool || workers_.empty() || count <= grain;
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::defer_lock);
+  if (!serial) serial = !run_lock.try_lock();
+  if (serial) {
+    fn(begin, end);
+    return;
+  }
+
+  // Несколько кусков на поток выравнивают нагрузку
+  int max_chunks = num_threads_ * 4;
+  int chunk = (count + max_chunks - 1) / max_chunks;
+  if (chunk < grain) chunk = grain;
+
+  {
+    // Опоздавшие рабочие прошлой задачи ещё могут читать её поля
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return busy_workers_ == 0; });
+    fn_ = &fn;
+    begin_ = begin;
+    end_ = end;
+    chunk_ = chunk;
+    chunks_ = (count + chunk - 1) / chunk;
+    next_chunk_ = 0;
+    finished_chunks_ = 0;
+    failed_ = false;
+    error_ = nullptr;
+    generation_++;
+  }
+  wake_.notify_all();
+
+  {
+    InsidePoolScope scope;
+    RunChunks();
+  }
+
+  // Ждём, пока рабочие закончат взятые куски: до этого fn_ должен жить
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return finished_chunks_ == chunks_; });
+    std::swap(error, error_);
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void S21SetNumThreads(int num_threads) {
+  S21ThreadPool::Instance().SetNumThreads(num_threads);
+}
+
+int S21GetNumThreads() { return S21ThreadPool::Instance().GetNumThreads(); }
@@ -0,0 +1,69 @@
+#ifndef __S21MATRIX_THREAD_POOL_H__
+#define __S21MATRIX_THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Постоянный пул потоков библиотеки. Вызывающий поток тоже участвует в
+// работе, поэтому пул из N потоков держит N - 1 рабочих.
+//
+// Размер пула по умолчанию берётся из переменной окружения S21_NUM_THREADS,
+// а если она не задана - из std::thread::hardware_concurrency().
+class S21ThreadPool {
+ public:
+  static S21ThreadPool &Instance();
+
+  S21ThreadPool(const S21ThreadPool &) = delete;
+  S21ThreadPool &operator=(const S21ThreadPool &) = delete;
+  ~S21ThreadPool();
+
+  // Меняет число потоков; num_threads <= 0 возвращает значение по умолчанию
+  void SetNumThreads(int num_threads);
+  int GetNumThreads();
+
+  // Делит [begin, end) на куски не меньше grain и вызывает fn(lo, hi) для
+  // каждого куска, блокируясь до завершения всех. Если пул занят другим
+  // вызовом или вызов вложенный, всё выполняется в вызывающем потоке.
+  // Исключение из fn пробрасывается вызывающему после завершения всех
+  // кусков; после первого исключения оставшиеся куски не выполняются.
+  void ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int)> &fn);
+
+ private:
+  S21ThreadPool();
+
+  void Start(int num_threads);
+  void Stop();
+  void WorkerLoop();
+  void RunChunks();  // Разбирает куски текущей задачи, пока они есть
+
+  std::vector<std::thread> workers_;
+  std::atomic<int> num_threads_;  // Читается без блокировки
+
+  std::mutex run_mutex_;  // Одна параллельная задача за раз
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  bool stop_;
+  unsigned long generation_;  // Номер текущей задачи
+
+  // Текущая задача
+  const std::function<void(int, int)> *fn_;
+  int begin_, end_, chunk_, chunks_;
+  std::atomic<int> next_chunk_;
+  std::atomic<int> finished_chunks_;
+  std::atomic<bool> failed_;  // Какой-то кусок бросил исключение
+  std::exception_ptr error_;  // Первое исключение задачи, под mutex_
+  int busy_workers_;  // Рабочие, которые сейчас внутри RunChunks
+};
+
+// Удобные обёртки над S21ThreadPool::Instance()
+void S21SetNumThreads(int num_threads);
+int S21GetNumThreads();
+
+#endif
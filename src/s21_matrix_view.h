@@ -0,0 +1,251 @@
+#ifndef __S21MATRIX_VIEW_H__
+#define __S21MATRIX_VIEW_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_stats.h"
+
+// Представление (view) прямоугольного блока матрицы без копирования.
+//
+// Хранит указатель на первый элемент блока, размеры и шаг строки исходной
+// матрицы; памятью не владеет. S21MatrixViewT<T> даёт чтение и запись,
+// S21MatrixViewT<const T> - только чтение. Представления возвращают
+// S21MatrixT::View(), Block(), Row() и Col(), а также Block(), Row() и Col()
+// самого представления.
+//
+// Представление действительно, пока жива матрица и не меняется её размер
+// (EditSize, SetRows, SetCols, присваивание матрицы другого размера).
+//
+// Копирование представления копирует ссылку на данные, а не элементы:
+// элементы переписывают Assign, SumMatrix, SubMatrix, MulNumber, Fill,
+// SetValue и операторы +=, -=, *=. Представление - лист ленивого выражения
+// (s21_matrix_expr.h): A.Block(...) + B.Block(...) не копирует блоки, а
+// S21Matrix m(view) создаёт матрицу из блока.
+//
+// Операции над представлением идут по строкам векторизованными ядрами
+// (s21_matrix_kernels.h) в вызывающем потоке: представления нужны блочным
+// алгоритмам, которые сами распределяют блоки между потоками.
+template <class T>
+class S21MatrixViewT : public S21MatrixExpr<S21MatrixViewT<T>> {
+  static_assert(std::is_floating_point<std::remove_const_t<T>>::value,
+                "S21MatrixViewT supports float, double and long double");
+
+ public:
+  using value_type = std::remove_const_t<T>;
+  using ConstView = S21MatrixViewT<const value_type>;
+
+  S21MatrixViewT(T *data, int rows, int cols, int stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+  // Представление для записи приводится к представлению для чтения
+  template <class U, class = std::enable_if_t<std::is_same<const U, T>::value &&
+                                              !std::is_same<U, T>::value>>
+  S21MatrixViewT(const S21MatrixViewT<U> &other)
+      : S21MatrixViewT(other.Data(), other.GetRows(), other.GetCols(),
+                       other.Stride()) {}
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  int Stride() const { return stride_; }  // Шаг строки исходной матрицы
+  T *Data() const { return data_; }       // Первый элемент блока
+
+  // Индексация по элементам блока (строка, колонка)
+  T &operator()(int i, int j) const {
+    if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
+      throw std::out_of_range("Incorrect input, index is out of range.");
+    }
+    return At(i, j);
+  }
+  void SetValue(int row, int col, value_type value) const {
+    (*this)(row, col) = value;
+  }
+
+  // Блок rows x cols с левым верхним углом в (row, col); блок может быть
+  // пустым (rows или cols равны 0), но не выходить за границы
+  S21MatrixViewT Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row > rows_ - rows ||
+        col > cols_ - cols) {
+      throw std::out_of_range("Incorrect input, block is out of range.");
+    }
+    return S21MatrixViewT(data_ + (std::ptrdiff_t)row * stride_ + col, rows,
+                          cols, stride_);
+  }
+  S21MatrixViewT Row(int row) const { return Block(row, 0, 1, cols_); }
+  S21MatrixViewT Col(int col) const { return Block(0, col, rows_, 1); }
+
+  // Поэлементное сравнение блоков
+  template <class U>
+  bool EqMatrix(const S21MatrixViewT<U> &other) const {
+    S21_STATS_SCOPE(kEqMatrix, rows_, cols_, 0);
+    ConstView src = other;
+    if (rows_ != src.rows_ || cols_ != src.cols_) return false;
+    const S21KernelsT<value_type> &kernels = S21GetKernels<value_type>();
+    for (int i = 0; i < rows_; i++)
+      if (!kernels.equal(&At(i, 0), &src.At(i, 0), cols_)) return false;
+    return true;
+  }
+  template <class U>
+  bool operator==(const S21MatrixViewT<U> &other) const {
+    return EqMatrix(other);
+  }
+
+  // Копирует элементы other в блок. Блоки одной матрицы могут
+  // перекрываться: строки обходятся в направлении, при котором источник
+  // не затирается раньше чтения.
+  template <class U>
+  void Assign(const S21MatrixViewT<U> &other) const {
+    ConstView src = CheckSize(other);
+    std::size_t bytes = (std::size_t)cols_ * sizeof(value_type);
+    if (bytes == 0) return;
+    if (std::less<const value_type *>()(src.data_, data_)) {
+      for (int i = rows_ - 1; i >= 0; i--)
+        std::memmove(&At(i, 0), &src.At(i, 0), bytes);
+    } else {
+      for (int i = 0; i < rows_; i++)
+        std::memmove(&At(i, 0), &src.At(i, 0), bytes);
+    }
+  }
+  // Записывает в блок значение выражения (одним проходом, как S21Matrix)
+  template <class E>
+  void Assign(const S21MatrixExpr<E> &expr) const {
+    EvalExpr<S21ExprAssign>(expr.Self());
+  }
+
+  void Fill(value_type value) const {
+    for (int i = 0; i < rows_; i++) std::fill_n(&At(i, 0), cols_, value);
+  }
+
+  template <class U>
+  void SumMatrix(const S21MatrixViewT<U> &other) const {  // Прибавляет блок
+    S21_STATS_SCOPE(kSumMatrix, rows_, cols_, (double)rows_ * cols_);
+    ConstView src = CheckSize(other);
+    const S21KernelsT<value_type> &kernels = S21GetKernels<value_type>();
+    for (int i = 0; i < rows_; i++)
+      kernels.add(&At(i, 0), &src.At(i, 0), cols_);
+  }
+  template <class U>
+  void SubMatrix(const S21MatrixViewT<U> &other) const {  // Вычитает блок
+    S21_STATS_SCOPE(kSubMatrix, rows_, cols_, (double)rows_ * cols_);
+    ConstView src = CheckSize(other);
+    const S21KernelsT<value_type> &kernels = S21GetKernels<value_type>();
+    for (int i = 0; i < rows_; i++)
+      kernels.sub(&At(i, 0), &src.At(i, 0), cols_);
+  }
+  void MulNumber(const value_type num) const {  // Умножает блок на число
+    S21_STATS_SCOPE(kMulNumber, rows_, cols_, (double)rows_ * cols_);
+    const S21KernelsT<value_type> &kernels = S21GetKernels<value_type>();
+    for (int i = 0; i < rows_; i++) kernels.scale(&At(i, 0), num, cols_);
+  }
+
+  // Блок = a * b (или += a * b при accumulate) через блочный GEMM без
+  // копирования операндов; блок не должен перекрываться с a и b
+  void AssignProduct(const ConstView &a, const ConstView &b,
+                     bool accumulate = false) const {
+    if (a.GetCols() != b.GetRows() || a.GetRows() != rows_ ||
+        b.GetCols() != cols_) {
+      throw std::out_of_range(
+          "Incorrect input. Number of first matrix columns "
+          "should be equal for second matrix rows");
+    }
+    S21_STATS_SCOPE(kMulMatrix, rows_, cols_,
+                    2.0 * rows_ * cols_ * a.GetCols());
+    if (rows_ == 0 || cols_ == 0) return;
+    if (a.GetCols() == 0) {
+      if (!accumulate) Fill(0);
+      return;
+    }
+    S21Gemm<value_type>(rows_, cols_, a.GetCols(), a.Data(), a.Stride(),
+                        b.Data(), b.Stride(), data_, stride_, accumulate);
+  }
+
+  template <class U>
+  const S21MatrixViewT &operator+=(const S21MatrixViewT<U> &other) const {
+    SumMatrix(other);
+    return *this;
+  }
+  template <class U>
+  const S21MatrixViewT &operator-=(const S21MatrixViewT<U> &other) const {
+    SubMatrix(other);
+    return *this;
+  }
+  const S21MatrixViewT &operator*=(const value_type num) const {
+    MulNumber(num);
+    return *this;
+  }
+  template <class E>
+  const S21MatrixViewT &operator+=(const S21MatrixExpr<E> &expr) const {
+    EvalExpr<S21ExprPlus>(expr.Self());
+    return *this;
+  }
+  template <class E>
+  const S21MatrixViewT &operator-=(const S21MatrixExpr<E> &expr) const {
+    EvalExpr<S21ExprMinus>(expr.Self());
+    return *this;
+  }
+
+  // Узел выражения (s21_matrix_expr.h)
+  int Rows() const { return rows_; }
+  int Cols() const { return cols_; }
+  value_type Eval(int i, int j) const { return At(i, j); }
+
+ private:
+  template <class U>
+  friend class S21MatrixViewT;
+
+  T &At(int row, int col) const {
+    return data_[(std::ptrdiff_t)row * stride_ + col];
+  }
+
+  // Проверяет размер второго операнда и приводит его к представлению для
+  // чтения
+  template <class U>
+  ConstView CheckSize(const S21MatrixViewT<U> &other) const {
+    static_assert(std::is_same<std::remove_const_t<U>, value_type>::value,
+                  "Views should have the same element type");
+    if (rows_ != other.rows_ || cols_ != other.cols_) {
+      throw std::out_of_range(
+          "Incorrect input: matriсes should have the same "
+          "size if you want to sum them.");
+    }
+    return other;
+  }
+
+  // block(i, j) = Op(block(i, j), expr(i, j)); выражение не должно читать
+  // элементы блока по другим индексам
+  template <class Op, class E>
+  void EvalExpr(const E &expr) const {
+    static_assert(!std::is_const<T>::value, "View is read-only");
+    static_assert(std::is_same<typename E::value_type, value_type>::value,
+                  "Expression should have the same element type as the view");
+    if (rows_ != expr.Rows() || cols_ != expr.Cols()) {
+      throw std::out_of_range(
+          "Incorrect input: matriсes should have the same "
+          "size if you want to sum them.");
+    }
+    S21_STATS_SCOPE(kExpression, rows_, cols_, (double)rows_ * cols_);
+    for (int i = 0; i < rows_; i++) {
+      T *row = &At(i, 0);
+      for (int j = 0; j < cols_; j++)
+        row[j] = Op::Apply(row[j], expr.Eval(i, j));
+    }
+  }
+
+  T *data_;
+  int rows_, cols_;
+  int stride_;
+};
+
+template <class T>
+using S21ConstMatrixViewT = S21MatrixViewT<const T>;
+
+using S21MatrixView = S21MatrixViewT<double>;
+using S21ConstMatrixView = S21MatrixViewT<const double>;
+
+#endif